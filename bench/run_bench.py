@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Run the BENCH=1 build of TIFPS under CEmu's autotester and write a JSON report.
+
+The bench build (make debug BENCH=1) replays canned scenes itself and prints
+one dbg_printf line per scene with CPU-timer cycle counts; this script feeds
+the program to the autotester, collects those lines and summarizes them.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+CPU_HZ = 48000000
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+LINE = re.compile(r"BENCH scene=(\S+) frames=(\d+) total=(\d+) min=(\d+) max=(\d+)")
+
+
+def git_commit():
+    try:
+        out = subprocess.run(["git", "rev-parse", "HEAD"], cwd=ROOT,
+                             capture_output=True, text=True, check=True)
+        return out.stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def build():
+    subprocess.run(["make", "clean"], cwd=ROOT, check=True)
+    subprocess.run(["make", "debug", "BENCH=1"], cwd=ROOT, check=True)
+
+
+def run_autotester(args):
+    with open(os.path.join(ROOT, "bench", "autotester.json")) as f:
+        config = json.load(f)
+
+    config["rom"] = os.path.abspath(args.rom)
+    config["transfer_files"] = [os.path.abspath(args.program)]
+
+    with tempfile.NamedTemporaryFile("w", suffix=".json", delete=False) as f:
+        json.dump(config, f, indent=4)
+        config_path = f.name
+
+    try:
+        result = subprocess.run([args.autotester, config_path], cwd=ROOT,
+                                capture_output=True, text=True, timeout=args.timeout)
+    finally:
+        os.unlink(config_path)
+
+    return result.stdout + result.stderr
+
+
+def parse(output):
+    scenes = []
+    for match in LINE.finditer(output):
+        name, frames, total, low, high = match.groups()
+        frames, total = int(frames), int(total)
+        avg = total / frames
+        scenes.append({
+            "scene": name,
+            "frames": frames,
+            "cycles_total": total,
+            "cycles_avg": round(avg),
+            "cycles_min": int(low),
+            "cycles_max": int(high),
+            "fps": round(CPU_HZ / avg, 2) if avg else None,
+        })
+    return scenes
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--rom", default=os.environ.get("CEMU_ROM"),
+                        help="TI-84 Plus CE ROM image (or set CEMU_ROM)")
+    parser.add_argument("--autotester", default=os.environ.get("CEMU_AUTOTESTER", "autotester"),
+                        help="path to CEmu's autotester binary")
+    parser.add_argument("--program", default=os.path.join(ROOT, "bin", "TIFPS.8xp"))
+    parser.add_argument("--build", action="store_true", help="rebuild with make debug BENCH=1 first")
+    parser.add_argument("--timeout", type=int, default=300)
+    parser.add_argument("--output", default="-", help="report path, - for stdout")
+    args = parser.parse_args()
+
+    if not args.rom:
+        parser.error("a ROM is required (--rom or CEMU_ROM)")
+
+    if args.build:
+        build()
+
+    output = run_autotester(args)
+    scenes = parse(output)
+    complete = "BENCH done" in output
+
+    report = {
+        "commit": git_commit(),
+        "cpu_hz": CPU_HZ,
+        "complete": complete,
+        "scenes": scenes,
+    }
+    text = json.dumps(report, indent=2) + "\n"
+
+    if args.output == "-":
+        sys.stdout.write(text)
+    else:
+        with open(args.output, "w") as f:
+            f.write(text)
+
+    if not complete:
+        sys.stderr.write(output)
+        sys.stderr.write("\nbench did not finish; autotester output above\n")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
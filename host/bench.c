@@ -0,0 +1,258 @@
+#include "host.h"
+#include <graphx.h>
+#include <keypadc.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fixed.h"
+#include "level.h"
+#include "player.h"
+#include "enemy.h"
+#include "input.h"
+#include "raycast.h"
+#include "blit.h"
+#include "ui.h"
+#include "replay.h"
+
+#define DEFAULT_FRAMES 240
+#define DEFAULT_SEEDS 8
+#define TOUR_FRAMES_PER_ROOM 32
+
+typedef struct {
+    uint8_t keys;
+    int frames;
+} path_step_t;
+
+/* A path replays keys through the input module, or tours the rooms when tour is set. */
+typedef struct {
+    const char *name;
+    const path_step_t *steps;
+    int step_count;
+    bool tour;
+} camera_path_t;
+
+static const path_step_t walk_steps[] = {
+    { kb_Up, 12 },
+    { kb_Left, 16 },
+    { kb_Up, 10 },
+    { kb_Right, 24 },
+    { kb_Up | kb_Left, 20 },
+    { kb_Down, 6 },
+    { kb_Right, 30 }
+};
+
+static const camera_path_t paths[] = {
+    { "walk", walk_steps, sizeof(walk_steps) / sizeof(walk_steps[0]), false },
+    { "tour", NULL, 0, true }
+};
+
+#if REPLAY_MODE != REPLAY_OFF
+static const camera_path_t replay_path = { "replay", NULL, 0, false };
+#endif
+
+#define PATH_COUNT ((int)(sizeof(paths) / sizeof(paths[0])))
+
+typedef struct {
+    uint64_t frames;
+    uint64_t rays;
+    uint64_t dda_steps;
+    uint64_t dda_jumps;
+    uint64_t draw_calls;
+    uint64_t pixels;
+    uint64_t sprites;
+    uint64_t sprite_rejects;
+    uint64_t update_ns;
+    uint64_t render_ns;
+} bench_totals_t;
+
+static uint8_t path_keys(const camera_path_t *path, int frame) {
+    if (path->step_count == 0) {
+        return 0;
+    }
+
+    int length = 0;
+    for (int i = 0; i < path->step_count; i++) {
+        length += path->steps[i].frames;
+    }
+
+    frame %= length;
+    for (int i = 0; i < path->step_count; i++) {
+        if (frame < path->steps[i].frames) {
+            return path->steps[i].keys;
+        }
+        frame -= path->steps[i].frames;
+    }
+    return 0;
+}
+
+static bool run_frame(const camera_path_t *path, int frame, bench_totals_t *totals) {
+    kb_Data[7] = path_keys(path, frame);
+
+    uint64_t start = host_time_ns();
+    input_poll();
+    input_tick();
+    if (input_down(INPUT_QUIT)) {
+        return false;
+    }
+    player_update();
+    enemy_update_all();
+    uint64_t mid = host_time_ns();
+
+    if (path->tour && level_get_room_count() > 0) {
+        const room_t *room = &level_get_rooms()[(frame / TOUR_FRAMES_PER_ROOM) % level_get_room_count()];
+        angle_t a = (angle_t)((frame % TOUR_FRAMES_PER_ROOM) * ANGLE_STEPS / TOUR_FRAMES_PER_ROOM);
+        player_set_pose(room->center_x + 0.5f, room->center_y + 0.5f, a);
+    }
+
+    host_gfx_reset_stats();
+    player_interpolate(LERP_ONE);
+    enemy_interpolate(LERP_ONE);
+    raycast_render();
+    raycast_render_enemies();
+    ui_render();
+    ui_render_crosshair();
+    gfx_SwapDraw();
+    uint64_t end = host_time_ns();
+
+    const raycast_stats_t *stats = raycast_get_stats();
+    totals->frames++;
+    totals->rays += (uint64_t)stats->rays_cast;
+    totals->dda_steps += (uint64_t)stats->dda_steps;
+    totals->dda_jumps += (uint64_t)stats->dda_jumps;
+    totals->draw_calls += host_gfx_stats.calls;
+    totals->pixels += host_gfx_stats.pixels;
+#if !BLIT_USE_GRAPHX
+    totals->draw_calls += (uint64_t)stats->spans_drawn;
+    totals->pixels += (uint64_t)stats->column_pixels;
+#endif
+    totals->sprites += (uint64_t)stats->sprites_drawn;
+    totals->sprite_rejects += (uint64_t)stats->sprite_columns_rejected;
+    totals->update_ns += mid - start;
+    totals->render_ns += end - mid;
+    return true;
+}
+
+static void add_totals(bench_totals_t *dst, const bench_totals_t *src) {
+    dst->frames += src->frames;
+    dst->rays += src->rays;
+    dst->dda_steps += src->dda_steps;
+    dst->dda_jumps += src->dda_jumps;
+    dst->draw_calls += src->draw_calls;
+    dst->pixels += src->pixels;
+    dst->sprites += src->sprites;
+    dst->sprite_rejects += src->sprite_rejects;
+    dst->update_ns += src->update_ns;
+    dst->render_ns += src->render_ns;
+}
+
+static void print_totals(const char *label, uint32_t seed, const bench_totals_t *t) {
+    double frames = (double)t->frames;
+    double rays = t->rays ? (double)t->rays : 1.0;
+    printf("%-6s %6u %8.1f %8.2f %8.2f %8.1f %9.0f %6.2f %6.1f %9.2f %9.2f\n", label, (unsigned)seed,
+           t->rays / frames,
+           t->dda_steps / rays,
+           t->dda_jumps / rays,
+           t->draw_calls / frames,
+           t->pixels / frames,
+           t->sprites / frames,
+           t->sprite_rejects / frames,
+           t->update_ns / frames / 1000.0,
+           t->render_ns / frames / 1000.0);
+}
+
+static void start_level(uint32_t seed) {
+    level_init(seed);
+    player_init();
+    enemy_init();
+    ui_init();
+    raycast_init();
+    input_init();
+}
+
+static void print_header(void) {
+    printf("%-6s %6s %8s %8s %8s %8s %9s %6s %6s %9s %9s\n", "path", "seed",
+           "rays/f", "steps/r", "jumps/r", "calls/f", "pixels/f", "spr/f", "rej/f", "upd_us/f", "rnd_us/f");
+}
+
+#if REPLAY_MODE != REPLAY_OFF
+/* Plays FPSREPL.appvar from the working directory: one rendered frame per recorded tick. */
+static int run_replay(void) {
+    uint32_t seed;
+    if (!replay_play_start(&seed)) {
+        fprintf(stderr, "no replay: FPSREPL.appvar missing or invalid\n");
+        return 1;
+    }
+
+    bench_totals_t totals = { 0 };
+    start_level(seed);
+    print_header();
+
+    for (int f = 0; run_frame(&replay_path, f, &totals); f++) {
+    }
+
+    print_totals(replay_path.name, seed, &totals);
+    printf("ticks %u final x %.4f y %.4f angle %u hp %d ammo %d\n",
+           (unsigned)replay_get_ticks(), player_get_x(), player_get_y(),
+           (unsigned)player_get_angle(), player_get_hp(), player_get_ammo());
+    if (replay_is_truncated()) {
+        printf("replay was cut short: the recording filled its buffer\n");
+    }
+    replay_stop();
+    return 0;
+}
+#endif
+
+static void usage(const char *argv0) {
+#if REPLAY_MODE != REPLAY_OFF
+    fprintf(stderr, "usage: %s [frames [seeds]] | -r\n", argv0);
+#else
+    fprintf(stderr, "usage: %s [frames [seeds]]\n", argv0);
+#endif
+    exit(2);
+}
+
+/* A positive decimal count, or the usage line. */
+static int parse_count(const char *arg, const char *argv0) {
+    char *end;
+    long value = strtol(arg, &end, 10);
+    if (end == arg || *end != '\0' || value < 1 || value > INT_MAX) {
+        usage(argv0);
+    }
+    return (int)value;
+}
+
+int main(int argc, char **argv) {
+#if REPLAY_MODE != REPLAY_OFF
+    if (argc > 1 && strcmp(argv[1], "-r") == 0) {
+        return run_replay();
+    }
+#endif
+
+    if (argc > 3) {
+        usage(argv[0]);
+    }
+    int frames = (argc > 1) ? parse_count(argv[1], argv[0]) : DEFAULT_FRAMES;
+    int seeds = (argc > 2) ? parse_count(argv[2], argv[0]) : DEFAULT_SEEDS;
+    bench_totals_t all = { 0 };
+
+    print_header();
+
+    for (int p = 0; p < PATH_COUNT; p++) {
+        for (int s = 1; s <= seeds; s++) {
+            bench_totals_t totals = { 0 };
+
+            start_level((uint32_t)s);
+
+            for (int f = 0; f < frames; f++) {
+                run_frame(&paths[p], f, &totals);
+            }
+
+            print_totals(paths[p].name, (uint32_t)s, &totals);
+            add_totals(&all, &totals);
+        }
+    }
+
+    print_totals("total", 0, &all);
+    return 0;
+}
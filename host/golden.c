@@ -0,0 +1,167 @@
+#include "host.h"
+#include <graphx.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fixed.h"
+#include "angle.h"
+#include "level.h"
+#include "player.h"
+#include "enemy.h"
+#include "input.h"
+#include "raycast.h"
+#include "blit.h"
+#include "ui.h"
+
+#define DEFAULT_TOLERANCE 8
+#define DEFAULT_MAX_BAD 150
+#define FULL_HEIGHT 240
+
+typedef struct {
+    const char *name;
+    uint32_t seed;
+    float x, y;
+    angle_t angle;
+    int ray_step;
+    int view_height;
+    int sprites;
+    bool clipped;
+} viewpoint_t;
+
+/*
+ * sprites is how many enemies the view must draw, so a golden can't silently
+ * lose its sprites; a clipped view must also have sprite columns rejected by
+ * the depth runs, i.e. a sprite cut off at a wall edge.
+ */
+static const viewpoint_t viewpoints[] = {
+    { "spawn", 1, 4.5f, 2.5f, 1024, 5, FULL_HEIGHT, 0, false },
+    { "crowd", 1, 21.5f, 8.5f, 2048, 5, FULL_HEIGHT, 2, false },
+    { "sprite", 1, 4.5f, 9.5f, 1428, 5, FULL_HEIGHT, 1, false },
+    { "occluded", 1, 19.5f, 8.5f, 2136, 5, FULL_HEIGHT, 1, true },
+    { "slant", 2, 16.5f, 3.5f, 209, 5, FULL_HEIGHT, 1, true },
+    { "hall", 1, 14.5f, 11.5f, 1024, 5, FULL_HEIGHT, 0, false },
+    { "corner", 2, 15.5f, 15.5f, 3584, 5, FULL_HEIGHT, 2, false },
+    { "fine", 2, 14.5f, 3.5f, 700, 2, FULL_HEIGHT, 0, false },
+    { "letterbox", 2, 3.5f, 12.5f, 980, 10, 160, 0, false }
+};
+
+#define VIEWPOINT_COUNT ((int)(sizeof(viewpoints) / sizeof(viewpoints[0])))
+
+static uint8_t frame_rgb[HOST_FRAME_BYTES];
+static uint8_t golden_rgb[HOST_FRAME_BYTES];
+
+static void render_viewpoint(const viewpoint_t *view) {
+    level_init(view->seed);
+    player_init();
+    enemy_init();
+    ui_init();
+    raycast_init();
+    input_init();
+
+    player_set_pose(view->x, view->y, view->angle);
+    enemy_interpolate(LERP_ONE);
+    raycast_set_resolution(view->ray_step, view->view_height);
+
+    raycast_render();
+    raycast_render_enemies();
+    ui_render();
+    ui_render_crosshair();
+
+    host_capture_rgb(frame_rgb, BLIT_COLUMN_MAJOR);
+}
+
+static int count_bad_pixels(int tolerance) {
+    int bad = 0;
+    for (int i = 0; i < HOST_FRAME_BYTES; i += 3) {
+        for (int c = 0; c < 3; c++) {
+            if (abs(frame_rgb[i + c] - golden_rgb[i + c]) > tolerance) {
+                bad++;
+                break;
+            }
+        }
+    }
+    return bad;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-u] [-t tolerance] [-m max_bad] [-o out_dir] golden_dir\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    bool update = false;
+    int tolerance = DEFAULT_TOLERANCE;
+    int max_bad = DEFAULT_MAX_BAD;
+    const char *out_dir = NULL;
+    const char *golden_dir = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-u") == 0) {
+            update = true;
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            tolerance = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            max_bad = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (argv[i][0] != '-' && golden_dir == NULL) {
+            golden_dir = argv[i];
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (golden_dir == NULL) {
+        usage(argv[0]);
+    }
+
+    int failures = 0;
+    char path[256];
+
+    for (int v = 0; v < VIEWPOINT_COUNT; v++) {
+        const viewpoint_t *view = &viewpoints[v];
+        render_viewpoint(view);
+
+        if (out_dir != NULL) {
+            snprintf(path, sizeof(path), "%s/%s.ppm", out_dir, view->name);
+            host_write_ppm(path, frame_rgb);
+        }
+
+        const raycast_stats_t *stats = raycast_get_stats();
+        if (stats->sprites_drawn != view->sprites) {
+            printf("FAIL %-10s drew %d sprites, expected %d\n", view->name, stats->sprites_drawn, view->sprites);
+            failures++;
+            continue;
+        }
+        if (view->clipped && stats->sprite_columns_rejected == 0) {
+            printf("FAIL %-10s no sprite columns clipped by walls\n", view->name);
+            failures++;
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%s/%s.ppm", golden_dir, view->name);
+        if (update) {
+            if (host_write_ppm(path, frame_rgb) != 0) {
+                printf("FAIL %-10s cannot write %s\n", view->name, path);
+                failures++;
+            } else {
+                printf("wrote %s\n", path);
+            }
+            continue;
+        }
+
+        if (host_read_ppm(path, golden_rgb) != 0) {
+            printf("FAIL %-10s missing or bad golden %s\n", view->name, path);
+            failures++;
+            continue;
+        }
+
+        int bad = count_bad_pixels(tolerance);
+        bool ok = bad <= max_bad;
+        printf("%s %-10s %6d pixels differ\n", ok ? "ok  " : "FAIL", view->name, bad);
+        if (!ok) {
+            failures++;
+        }
+    }
+
+    return failures ? 1 : 0;
+}
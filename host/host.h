@@ -0,0 +1,24 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HOST_FRAME_BYTES (320 * 240 * 3)
+
+typedef struct {
+    uint32_t calls;
+    uint32_t pixels;
+} host_gfx_stats_t;
+
+extern host_gfx_stats_t host_gfx_stats;
+
+void host_gfx_reset_stats(void);
+void host_palette_rgb(uint8_t index, uint8_t rgb[3]);
+uint64_t host_time_ns(void);
+
+int host_capture_rgb(uint8_t *rgb, bool column_major);
+int host_write_ppm(const char *path, const uint8_t *rgb);
+int host_read_ppm(const char *path, uint8_t *rgb);
+
+#endif
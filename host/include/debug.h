@@ -0,0 +1,8 @@
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <stdio.h>
+
+#define dbg_printf(...) printf(__VA_ARGS__)
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef GRAPHX_H
+#define GRAPHX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GFX_LCD_WIDTH 320
+#define GFX_LCD_HEIGHT 240
+
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    uint8_t data[];
+} gfx_sprite_t;
+
+extern uint8_t (*host_vbuffer)[GFX_LCD_HEIGHT][GFX_LCD_WIDTH];
+#define gfx_vbuffer (*host_vbuffer)
+
+#define gfx_RGBTo1555(r, g, b) \
+    ((uint16_t)((((uint8_t)(r) >> 3) << 10) | (((uint8_t)(g) >> 3) << 5) | ((uint8_t)(b) >> 3)))
+
+void gfx_Begin(void);
+void gfx_End(void);
+void gfx_SetDrawBuffer(void);
+void gfx_SetDrawScreen(void);
+void gfx_SwapDraw(void);
+uint8_t gfx_SetColor(uint8_t color);
+void gfx_SetPalette(const void *palette, uint24_t size, uint8_t offset);
+void gfx_FillScreen(uint8_t color);
+void gfx_SetPixel(int x, int y);
+void gfx_HorizLine(int x, int y, int length);
+void gfx_VertLine(int x, int y, int length);
+void gfx_Line(int x0, int y0, int x1, int y1);
+void gfx_Rectangle(int x, int y, int width, int height);
+void gfx_FillRectangle(int x, int y, int width, int height);
+uint8_t gfx_SetTextFGColor(uint8_t color);
+void gfx_SetTextXY(int x, int y);
+void gfx_PrintString(const char *string);
+void gfx_PrintStringXY(const char *string, int x, int y);
+void gfx_PrintUInt(unsigned int n, uint8_t length);
+
+#endif
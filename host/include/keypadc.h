@@ -0,0 +1,19 @@
+#ifndef KEYPADC_H
+#define KEYPADC_H
+
+#include <stdint.h>
+
+extern uint8_t kb_Data[8];
+
+void kb_Scan(void);
+uint8_t kb_AnyKey(void);
+
+#define kb_2nd (1 << 5)
+#define kb_Mode (1 << 6)
+#define kb_Clear (1 << 6)
+#define kb_Down (1 << 0)
+#define kb_Left (1 << 1)
+#define kb_Right (1 << 2)
+#define kb_Up (1 << 3)
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SYS_TIMERS_H
+#define SYS_TIMERS_H
+
+#include <stdint.h>
+
+#define TIMER_CPU 0
+#define TIMER_32K 1
+#define TIMER_NOINT 0
+#define TIMER_0INT 1
+#define TIMER_UP 0
+#define TIMER_DOWN 1
+
+void timer_Enable(uint8_t n, uint8_t rate, uint8_t interrupt, uint8_t direction);
+void timer_Disable(uint8_t n);
+void timer_Set(uint8_t n, uint32_t value);
+uint32_t timer_Get(uint8_t n);
+
+#endif
@@ -0,0 +1,147 @@
+#include "host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "level.h"
+
+#define DEFAULT_SEEDS 64
+#define SLIDE_SEEDS 64
+
+static uint8_t seen[LEVEL_MAP_ROWS * LEVEL_MAP_COLS];
+static int queue[MAP_WIDTH * MAP_HEIGHT];
+
+/* Flood-fills walkable cells from the spawn room and checks every room, the last holding the exit, is reached. */
+static bool level_connected(void) {
+    const room_t *rooms = level_get_rooms();
+    int count = level_get_room_count();
+    if (count == 0) {
+        return false;
+    }
+
+    memset(seen, 0, sizeof(seen));
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = rooms[0].center_y * MAP_WIDTH + rooms[0].center_x;
+    seen[(rooms[0].center_y + 1) * LEVEL_MAP_COLS + rooms[0].center_x + 1] = 1;
+
+    static const int dx[4] = { 1, -1, 0, 0 };
+    static const int dy[4] = { 0, 0, 1, -1 };
+    while (head < tail) {
+        int x = queue[head] % MAP_WIDTH;
+        int y = queue[head] / MAP_WIDTH;
+        head++;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dx[d];
+            int ny = y + dy[d];
+            uint8_t *s = &seen[(ny + 1) * LEVEL_MAP_COLS + nx + 1];
+            if (*s || LEVEL_SOLID(nx, ny)) continue;
+            *s = 1;
+            queue[tail++] = ny * MAP_WIDTH + nx;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!seen[(rooms[i].center_y + 1) * LEVEL_MAP_COLS + rooms[i].center_x + 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Reports level RAM and timing for the MAP_WIDTH x MAP_HEIGHT this binary was
+ * built with: generation time per level_init() over the given number of
+ * seeds, the seeds whose rooms or exit are not all reachable from spawn, the
+ * size, largest fill, overflowing seeds, build time and density of the zone
+ * PVS, and the cost of sliding the window while walking the focus cell by
+ * cell along every row of the map.
+ */
+int main(int argc, char **argv) {
+    int arg = 1;
+    if (argc > arg && strcmp(argv[arg], "-h") == 0) {
+        printf("%-8s %6s %6s %6s %6s %7s %7s %8s %8s %8s %7s %6s %6s %7s %7s %8s %6s %8s %9s\n",
+               "map", "pack", "solid", "window", "pvs", "total", "flat", "seeds", "gen_us",
+               "max_us", "rooms", "fails", "zones", "pvs_max", "pvs_ovf", "pvs_us", "vis%",
+               "slides", "slide_us");
+        arg++;
+    }
+    uint32_t seeds = (argc > arg) ? (uint32_t)strtoul(argv[arg], NULL, 10) : DEFAULT_SEEDS;
+
+    uint64_t gen_ns = 0;
+    uint64_t gen_max_ns = 0;
+    uint64_t rooms = 0;
+    uint64_t zones = 0;
+    uint64_t pairs = 0;
+    uint64_t visible = 0;
+    uint64_t pvs_ns = 0;
+    int pvs_max = 0;
+    uint32_t pvs_overflows = 0;
+    uint64_t slide_ns = 0;
+    uint64_t slides = 0;
+    uint32_t fails = 0;
+
+    for (uint32_t seed = 1; seed <= seeds; seed++) {
+        uint64_t start = host_time_ns();
+        level_init(seed);
+        uint64_t t = host_time_ns() - start;
+        gen_ns += t;
+        if (t > gen_max_ns) gen_max_ns = t;
+        rooms += (uint64_t)level_get_room_count();
+
+        start = host_time_ns();
+        level_build_pvs();
+        pvs_ns += host_time_ns() - start;
+
+        int count = level_get_zone_count();
+        zones += (uint64_t)count;
+        if (level_pvs_start[count] > pvs_max) pvs_max = level_pvs_start[count];
+        if (level_pvs_listed < count) pvs_overflows++;
+        pairs += (uint64_t)(count * count);
+        for (int a = 0; a < count; a++) {
+            for (int b = 0; b < count; b++) {
+                visible += level_zone_sees(a, b);
+            }
+        }
+
+        if (!level_connected()) {
+            if (fails < 10) fprintf(stderr, "%dx%d seed %u: not connected\n", MAP_WIDTH, MAP_HEIGHT, (unsigned)seed);
+            fails++;
+        }
+
+        if (seed > SLIDE_SEEDS) continue;
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            for (int i = 0; i < MAP_WIDTH; i++) {
+                int x = (y & 1) ? MAP_WIDTH - 1 - i : i;
+                int base = level_window_base;
+                start = host_time_ns();
+                level_focus(x, y);
+                t = host_time_ns() - start;
+                if (level_window_base != base) {
+                    slide_ns += t;
+                    slides++;
+                }
+            }
+        }
+    }
+
+    uint32_t slide_seeds = (seeds < SLIDE_SEEDS) ? seeds : SLIDE_SEEDS;
+    size_t window = sizeof(level_window) + sizeof(level_dist);
+#if LEVEL_PACKED
+    size_t pack = sizeof(level_pack);
+#else
+    size_t pack = 0;
+#endif
+    size_t pvs = sizeof(level_pvs) + sizeof(level_pvs_start);
+    size_t total = pack + sizeof(level_solid) + window + pvs;
+    size_t flat = 2 * LEVEL_MAP_COLS * LEVEL_MAP_ROWS + sizeof(level_solid);
+    char name[16];
+    snprintf(name, sizeof(name), "%dx%d", MAP_WIDTH, MAP_HEIGHT);
+    printf("%-8s %6zu %6zu %6zu %6zu %7zu %7zu %8u %8.1f %8.1f %7.1f %6u %6.1f %7d %7u %8.1f %6.1f %8llu %9.2f\n",
+           name, pack, sizeof(level_solid), window, pvs, total, flat,
+           (unsigned)seeds, gen_ns / (double)seeds / 1000.0, gen_max_ns / 1000.0,
+           rooms / (double)seeds, (unsigned)fails, zones / (double)seeds,
+           pvs_max, (unsigned)pvs_overflows, pvs_ns / (double)seeds / 1000.0, 100.0 * visible / (double)pairs,
+           (unsigned long long)(slide_seeds ? slides / slide_seeds : 0),
+           slides ? slide_ns / (double)slides / 1000.0 : 0.0);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#include "host.h"
+#include <graphx.h>
+#include <stdio.h>
+
+#define PPM_WIDTH GFX_LCD_WIDTH
+#define PPM_HEIGHT GFX_LCD_HEIGHT
+
+/* column_major reads the buffer the way BLIT_COLUMN_MAJOR builds lay it out. */
+int host_capture_rgb(uint8_t *rgb, bool column_major) {
+    const uint8_t *pixels = &gfx_vbuffer[0][0];
+
+    for (int y = 0; y < PPM_HEIGHT; y++) {
+        for (int x = 0; x < PPM_WIDTH; x++) {
+            uint8_t index = column_major ? pixels[x * PPM_HEIGHT + y] : pixels[y * PPM_WIDTH + x];
+            host_palette_rgb(index, &rgb[(y * PPM_WIDTH + x) * 3]);
+        }
+    }
+    return PPM_WIDTH * PPM_HEIGHT * 3;
+}
+
+int host_write_ppm(const char *path, const uint8_t *rgb) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", PPM_WIDTH, PPM_HEIGHT);
+    size_t size = (size_t)PPM_WIDTH * PPM_HEIGHT * 3;
+    int ok = fwrite(rgb, 1, size, f) == size;
+    fclose(f);
+    return ok ? 0 : -1;
+}
+
+int host_read_ppm(const char *path, uint8_t *rgb) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    int width, height, max;
+    int ok = fscanf(f, "P6 %d %d %d", &width, &height, &max) == 3 &&
+             width == PPM_WIDTH && height == PPM_HEIGHT && max == 255 &&
+             fgetc(f) != EOF;
+    if (ok) {
+        size_t size = (size_t)PPM_WIDTH * PPM_HEIGHT * 3;
+        ok = fread(rgb, 1, size, f) == size;
+    }
+    fclose(f);
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,63 @@
+#include "host.h"
+#include <graphx.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "blit.h"
+#include "sprite.h"
+
+#define DEFAULT_DRAWS 20000
+
+static const char *type_names[ENEMY_TYPE_COUNT] = { "imp", "demon", "baron" };
+
+static int opaque_texels(enemy_type_t type, int level) {
+    int size = sprite_mip_size(level);
+    const uint8_t *texels = sprite_mip(type, level);
+    int count = 0;
+    for (int i = 0; i < size * size; i++) {
+        count += texels[i] != 0;
+    }
+    return count;
+}
+
+/*
+ * Reports the sprite mip cache: bytes per mip level for all enemy types, the
+ * opaque texels each draw writes, and the host time of one unclipped,
+ * unzoomed draw per level and type, averaged over the given number of draws.
+ */
+int main(int argc, char **argv) {
+    int draws = (argc > 1) ? atoi(argv[1]) : DEFAULT_DRAWS;
+    size_t total = 0;
+
+    uint64_t start = host_time_ns();
+    sprite_init();
+    uint64_t init_ns = host_time_ns() - start;
+
+    blit_set_view(0, 240, 0);
+    printf("%-5s %5s %7s", "level", "size", "bytes");
+    for (int type = 0; type < ENEMY_TYPE_COUNT; type++) {
+        printf(" %6s_px %6s_ns", type_names[type], type_names[type]);
+    }
+    printf("\n");
+
+    for (int level = 0; level < SPRITE_MIP_COUNT; level++) {
+        int size = sprite_mip_size(level);
+        sprite_pick_t pick = { (uint8_t)level, 1 };
+        total += sprite_mip_bytes(level);
+        printf("%-5d %5d %7zu", level, size, sprite_mip_bytes(level));
+
+        for (int type = 0; type < ENEMY_TYPE_COUNT; type++) {
+            int x = 160 - size / 2;
+            int y = 120 - size / 2;
+            start = host_time_ns();
+            for (int i = 0; i < draws; i++) {
+                sprite_blit((enemy_type_t)type, pick, x, y, x, x + size - 1);
+            }
+            uint64_t ns = host_time_ns() - start;
+            printf(" %9d %9.1f", opaque_texels((enemy_type_t)type, level), ns / (double)draws);
+        }
+        printf("\n");
+    }
+
+    printf("cache %zu bytes, built in %.1f us\n", total, init_ns / 1000.0);
+    return 0;
+}
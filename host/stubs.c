@@ -0,0 +1,273 @@
+#include "host.h"
+#include <graphx.h>
+#include <keypadc.h>
+#include <fileioc.h>
+#include <sys/timers.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOST_FILES 8
+#define CPU_HZ 48000000ULL
+#define SLOW_HZ 32768ULL
+
+static uint8_t buffers[2][GFX_LCD_HEIGHT][GFX_LCD_WIDTH];
+uint8_t (*host_vbuffer)[GFX_LCD_HEIGHT][GFX_LCD_WIDTH] = &buffers[1];
+uint8_t kb_Data[8];
+host_gfx_stats_t host_gfx_stats;
+
+static uint8_t draw_color = 0;
+static uint16_t palette[256];
+static bool palette_ready = false;
+static FILE *files[HOST_FILES];
+static uint64_t timer_base[4];
+static uint32_t timer_offset[4];
+static uint8_t timer_rate[4];
+static bool timer_running[4];
+
+uint64_t host_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void host_gfx_reset_stats(void) {
+    host_gfx_stats.calls = 0;
+    host_gfx_stats.pixels = 0;
+}
+
+static void fill_rect(int x, int y, int width, int height, uint8_t color) {
+    int x1 = x + width;
+    int y1 = y + height;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > GFX_LCD_WIDTH) x1 = GFX_LCD_WIDTH;
+    if (y1 > GFX_LCD_HEIGHT) y1 = GFX_LCD_HEIGHT;
+
+    host_gfx_stats.calls++;
+    if (x1 <= x || y1 <= y) {
+        return;
+    }
+
+    host_gfx_stats.pixels += (uint32_t)((x1 - x) * (y1 - y));
+    for (int row = y; row < y1; row++) {
+        memset(&gfx_vbuffer[row][x], color, (size_t)(x1 - x));
+    }
+}
+
+static void plot(int x, int y) {
+    if (x >= 0 && x < GFX_LCD_WIDTH && y >= 0 && y < GFX_LCD_HEIGHT) {
+        gfx_vbuffer[y][x] = draw_color;
+        host_gfx_stats.pixels++;
+    }
+}
+
+/* Entries the game never sets fall back to a gray ramp, so 0 is black and 255 white. */
+static void palette_reset(void) {
+    for (int i = 0; i < 256; i++) {
+        int level = i >> 3;
+        palette[i] = (uint16_t)((level << 10) | (level << 5) | level);
+    }
+    palette_ready = true;
+}
+
+void host_palette_rgb(uint8_t index, uint8_t rgb[3]) {
+    if (!palette_ready) {
+        palette_reset();
+    }
+    uint16_t c = palette[index];
+    rgb[0] = (uint8_t)(((c >> 10) & 0x1F) << 3);
+    rgb[1] = (uint8_t)(((c >> 5) & 0x1F) << 3);
+    rgb[2] = (uint8_t)((c & 0x1F) << 3);
+}
+
+void kb_Scan(void) {
+}
+
+uint8_t kb_AnyKey(void) {
+    uint8_t any = 0;
+    for (int i = 1; i < 8; i++) {
+        any |= kb_Data[i];
+    }
+    return any;
+}
+
+void gfx_Begin(void) {
+}
+
+void gfx_End(void) {
+}
+
+void gfx_SetDrawBuffer(void) {
+}
+
+void gfx_SetDrawScreen(void) {
+}
+
+void gfx_SwapDraw(void) {
+    host_vbuffer = (host_vbuffer == &buffers[0]) ? &buffers[1] : &buffers[0];
+    host_gfx_stats.calls++;
+}
+
+uint8_t gfx_SetColor(uint8_t color) {
+    uint8_t old = draw_color;
+    draw_color = color;
+    return old;
+}
+
+void gfx_SetPalette(const void *data, uint24_t size, uint8_t offset) {
+    if (!palette_ready) {
+        palette_reset();
+    }
+    size_t count = size / sizeof(uint16_t);
+    if (offset + count > 256) {
+        count = 256 - offset;
+    }
+    memcpy(&palette[offset], data, count * sizeof(uint16_t));
+}
+
+void gfx_FillScreen(uint8_t color) {
+    fill_rect(0, 0, GFX_LCD_WIDTH, GFX_LCD_HEIGHT, color);
+}
+
+void gfx_SetPixel(int x, int y) {
+    host_gfx_stats.calls++;
+    plot(x, y);
+}
+
+void gfx_HorizLine(int x, int y, int length) {
+    fill_rect(x, y, length, 1, draw_color);
+}
+
+void gfx_VertLine(int x, int y, int length) {
+    fill_rect(x, y, 1, length, draw_color);
+}
+
+void gfx_Line(int x0, int y0, int x1, int y1) {
+    int dx = abs(x1 - x0);
+    int dy = -abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx + dy;
+
+    host_gfx_stats.calls++;
+    for (;;) {
+        plot(x0, y0);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void gfx_Rectangle(int x, int y, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    fill_rect(x, y, width, 1, draw_color);
+    fill_rect(x, y + height - 1, width, 1, draw_color);
+    fill_rect(x, y, 1, height, draw_color);
+    fill_rect(x + width - 1, y, 1, height, draw_color);
+    host_gfx_stats.calls -= 3;
+}
+
+void gfx_FillRectangle(int x, int y, int width, int height) {
+    fill_rect(x, y, width, height, draw_color);
+}
+
+uint8_t gfx_SetTextFGColor(uint8_t color) {
+    return color;
+}
+
+void gfx_SetTextXY(int x, int y) {
+    (void)x;
+    (void)y;
+}
+
+void gfx_PrintString(const char *string) {
+    (void)string;
+    host_gfx_stats.calls++;
+}
+
+void gfx_PrintStringXY(const char *string, int x, int y) {
+    (void)string;
+    (void)x;
+    (void)y;
+    host_gfx_stats.calls++;
+}
+
+void gfx_PrintUInt(unsigned int n, uint8_t length) {
+    (void)n;
+    (void)length;
+    host_gfx_stats.calls++;
+}
+
+void lcd_set_column_major(bool enable) {
+    (void)enable;
+}
+
+void timer_Enable(uint8_t n, uint8_t rate, uint8_t interrupt, uint8_t direction) {
+    (void)interrupt;
+    (void)direction;
+    timer_rate[n] = rate;
+    timer_base[n] = host_time_ns();
+    timer_running[n] = true;
+}
+
+void timer_Disable(uint8_t n) {
+    timer_offset[n] = timer_Get(n);
+    timer_running[n] = false;
+}
+
+void timer_Set(uint8_t n, uint32_t value) {
+    timer_offset[n] = value;
+    timer_base[n] = host_time_ns();
+}
+
+uint32_t timer_Get(uint8_t n) {
+    if (!timer_running[n]) {
+        return timer_offset[n];
+    }
+    uint64_t hz = (timer_rate[n] == TIMER_CPU) ? CPU_HZ : SLOW_HZ;
+    uint64_t elapsed = host_time_ns() - timer_base[n];
+    return timer_offset[n] + (uint32_t)(elapsed * hz / 1000000000ULL);
+}
+
+/* AppVars are plain NAME.appvar files in the working directory. */
+uint8_t ti_Open(const char *name, const char *mode) {
+    char path[32];
+    snprintf(path, sizeof(path), "%s.appvar", name);
+
+    const char *fmode = (mode[0] == 'w') ? "wb" : (mode[0] == 'a') ? "ab" : "rb";
+    for (uint8_t i = 1; i < HOST_FILES; i++) {
+        if (files[i] == NULL) {
+            files[i] = fopen(path, fmode);
+            return files[i] ? i : 0;
+        }
+    }
+    return 0;
+}
+
+size_t ti_Write(const void *data, size_t size, size_t count, uint8_t handle) {
+    return fwrite(data, size, count, files[handle]);
+}
+
+size_t ti_Read(void *data, size_t size, size_t count, uint8_t handle) {
+    return fread(data, size, count, files[handle]);
+}
+
+int ti_Close(uint8_t handle) {
+    int ok = fclose(files[handle]) == 0;
+    files[handle] = NULL;
+    return ok;
+}
@@ -0,0 +1,48 @@
+#ifndef ANGLE_H
+#define ANGLE_H
+
+#include <stdint.h>
+#include "fixed.h"
+
+/* Binary angle: ANGLE_STEPS units per full turn, wrapping with ANGLE_MASK. */
+
+#define ANGLE_BITS 12
+#define ANGLE_STEPS (1 << ANGLE_BITS)
+#define ANGLE_MASK (ANGLE_STEPS - 1)
+#define ANGLE_HALF (ANGLE_STEPS / 2)
+#define ANGLE_QUARTER (ANGLE_STEPS / 4)
+
+#define ATAN_TABLE_BITS 8
+#define ATAN_TABLE_SIZE (1 << ATAN_TABLE_BITS)
+
+typedef uint16_t angle_t;
+
+extern const trig_t angle_sin_table[ANGLE_QUARTER + 1];
+
+static inline trig_t angle_sin(angle_t a) {
+    a &= ANGLE_MASK;
+    if (a < ANGLE_QUARTER) {
+        return angle_sin_table[a];
+    }
+    if (a < ANGLE_HALF) {
+        return angle_sin_table[ANGLE_HALF - a];
+    }
+    if (a < ANGLE_HALF + ANGLE_QUARTER) {
+        return -angle_sin_table[a - ANGLE_HALF];
+    }
+    return -angle_sin_table[ANGLE_STEPS - a];
+}
+
+static inline trig_t angle_cos(angle_t a) {
+    return angle_sin((angle_t)(a + ANGLE_QUARTER));
+}
+
+/* Signed shortest turn from b to a, in (-ANGLE_HALF, ANGLE_HALF]. */
+static inline int angle_diff(angle_t a, angle_t b) {
+    int d = (int)((a - b) & ANGLE_MASK);
+    return (d > ANGLE_HALF) ? d - ANGLE_STEPS : d;
+}
+
+angle_t angle_atan2(int32_t y, int32_t x);
+
+#endif
@@ -0,0 +1,89 @@
+#include "bench.h"
+
+#if BENCH_MODE
+#include "level.h"
+#include "player.h"
+#include "enemy.h"
+#include "input.h"
+#include "raycast.h"
+#include "ui.h"
+#include "fixed.h"
+#include "angle.h"
+#include <debug.h>
+#include <graphx.h>
+#include <sys/timers.h>
+#include <stdint.h>
+
+#define BENCH_TIMER 2
+#define BENCH_FRAMES 64
+#define BENCH_TURN 16
+
+typedef struct {
+    const char *name;
+    uint32_t seed;
+    float x, y;
+    angle_t angle;
+    int turn;
+} bench_scene_t;
+
+static const bench_scene_t scenes[] = {
+    { "spawn", 1, 4.5f, 2.5f, 0, BENCH_TURN },
+    { "corridor", 1, 14.5f, 11.5f, 1024, 0 },
+    { "crowd", 1, 21.5f, 8.5f, 2048, BENCH_TURN / 4 }
+};
+
+#define SCENE_COUNT ((int)(sizeof(scenes) / sizeof(scenes[0])))
+
+/* One frame: a tick of player and AI, the full render, and the swap, as in the game loop. */
+static void run_scene(const bench_scene_t *scene) {
+    uint32_t total = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+
+    level_init(scene->seed);
+    player_init();
+    enemy_init();
+    ui_init();
+    raycast_init();
+    input_init();
+
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        player_set_pose(scene->x, scene->y, (angle_t)(scene->angle + f * scene->turn));
+
+        uint32_t start = timer_Get(BENCH_TIMER);
+        input_tick();
+        player_update();
+        enemy_update_all();
+        player_interpolate(LERP_ONE);
+        enemy_interpolate(LERP_ONE);
+        raycast_render();
+        raycast_render_enemies();
+        ui_render();
+        ui_render_crosshair();
+        gfx_SwapDraw();
+        uint32_t cycles = timer_Get(BENCH_TIMER) - start;
+
+        total += cycles;
+        if (cycles < min) min = cycles;
+        if (cycles > max) max = cycles;
+    }
+
+    dbg_printf("BENCH scene=%s frames=%d total=%lu min=%lu max=%lu\n",
+               scene->name, BENCH_FRAMES,
+               (unsigned long)total, (unsigned long)min, (unsigned long)max);
+}
+
+void bench_run(void) {
+    timer_Disable(BENCH_TIMER);
+    timer_Set(BENCH_TIMER, 0);
+    timer_Enable(BENCH_TIMER, TIMER_CPU, TIMER_NOINT, TIMER_UP);
+
+    for (int i = 0; i < SCENE_COUNT; i++) {
+        run_scene(&scenes[i]);
+    }
+
+    dbg_printf("BENCH done\n");
+    level_cleanup();
+    enemy_cleanup();
+}
+#endif
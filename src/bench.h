@@ -0,0 +1,12 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#ifndef BENCH_MODE
+#define BENCH_MODE 0
+#endif
+
+#if BENCH_MODE
+void bench_run(void);
+#endif
+
+#endif
@@ -0,0 +1,369 @@
+#include "blit.h"
+#include "texture.h"
+#include <graphx.h>
+#include <stdbool.h>
+#include <string.h>
+#if BLIT_COLUMN_MAJOR
+#include "lcd.h"
+#endif
+
+#define SCREEN_WIDTH 320
+#define SCREEN_HEIGHT 240
+
+#define WIDE_SPAN_MIN 8
+
+static int view_top = 0;
+static int view_bottom = SCREEN_HEIGHT;
+static uint8_t view_border = 0;
+
+void blit_set_view(int top, int bottom, uint8_t border_color) {
+    view_top = top;
+    view_bottom = bottom;
+    view_border = border_color;
+}
+
+#if BLIT_USE_GRAPHX
+static inline void draw_segment(int x, int width, int y1, int y2, uint8_t color) {
+    if (y2 < y1) {
+        return;
+    }
+    gfx_SetColor(color);
+    gfx_FillRectangle(x, y1, width, y2 - y1 + 1);
+}
+
+void blit_begin(uint8_t clear_color) {
+    gfx_SetColor(clear_color);
+    gfx_FillScreen(clear_color);
+    draw_segment(0, SCREEN_WIDTH, 0, view_top - 1, view_border);
+    draw_segment(0, SCREEN_WIDTH, view_bottom, SCREEN_HEIGHT - 1, view_border);
+}
+
+void blit_column(int x, int width, int wall_start, int wall_end,
+                 uint8_t ceiling_color, uint8_t wall_color, uint8_t floor_color) {
+    draw_segment(x, width, view_top, wall_start - 1, ceiling_color);
+    draw_segment(x, width, wall_start, wall_end, wall_color);
+    draw_segment(x, width, wall_end + 1, view_bottom - 1, floor_color);
+}
+
+void blit_textured_column(int x, int width, int wall_start, int wall_end,
+                          uint8_t ceiling_color, uint8_t floor_color,
+                          const uint8_t *texels, const uint8_t *colors, int pos, int step) {
+    draw_segment(x, width, view_top, wall_start - 1, ceiling_color);
+    int start = wall_start;
+    uint8_t color = colors[texels[pos >> TEX_STEP_SHIFT]];
+    for (int y = wall_start + 1; y <= wall_end; y++) {
+        pos += step;
+        uint8_t next = colors[texels[pos >> TEX_STEP_SHIFT]];
+        if (next != color) {
+            draw_segment(x, width, start, y - 1, color);
+            color = next;
+            start = y;
+        }
+    }
+    draw_segment(x, width, start, wall_end, color);
+    draw_segment(x, width, wall_end + 1, view_bottom - 1, floor_color);
+}
+#elif BLIT_COLUMN_MAJOR
+#define FRAMEBUFFER ((uint8_t (*)[SCREEN_HEIGHT])&gfx_vbuffer[0][0])
+
+void blit_begin(uint8_t clear_color) {
+    (void)clear_color;
+}
+
+void blit_column(int x, int width, int wall_start, int wall_end,
+                 uint8_t ceiling_color, uint8_t wall_color, uint8_t floor_color) {
+    int floor_start = (wall_end >= wall_start) ? wall_end + 1 : wall_start;
+    uint8_t *first = FRAMEBUFFER[x];
+
+    memset(first, view_border, view_top);
+    memset(first + view_top, ceiling_color, wall_start - view_top);
+    memset(first + wall_start, wall_color, floor_start - wall_start);
+    memset(first + floor_start, floor_color, view_bottom - floor_start);
+    memset(first + view_bottom, view_border, SCREEN_HEIGHT - view_bottom);
+
+    for (int col = 1; col < width; col++) {
+        memcpy(FRAMEBUFFER[x + col], first, SCREEN_HEIGHT);
+    }
+}
+
+void blit_textured_column(int x, int width, int wall_start, int wall_end,
+                          uint8_t ceiling_color, uint8_t floor_color,
+                          const uint8_t *texels, const uint8_t *colors, int pos, int step) {
+    int floor_start = (wall_end >= wall_start) ? wall_end + 1 : wall_start;
+    uint8_t *first = FRAMEBUFFER[x];
+
+    memset(first, view_border, view_top);
+    memset(first + view_top, ceiling_color, wall_start - view_top);
+    uint8_t *dst = first + wall_start;
+    for (int rows = floor_start - wall_start; rows > 0; rows--) {
+        *dst++ = colors[texels[pos >> TEX_STEP_SHIFT]];
+        pos += step;
+    }
+    memset(first + floor_start, floor_color, view_bottom - floor_start);
+    memset(first + view_bottom, view_border, SCREEN_HEIGHT - view_bottom);
+
+    for (int col = 1; col < width; col++) {
+        memcpy(FRAMEBUFFER[x + col], first, SCREEN_HEIGHT);
+    }
+}
+#else
+static uint8_t *fill_strided(uint8_t *dst, int count, uint8_t color) {
+    while (count >= 8) {
+        dst[0 * SCREEN_WIDTH] = color;
+        dst[1 * SCREEN_WIDTH] = color;
+        dst[2 * SCREEN_WIDTH] = color;
+        dst[3 * SCREEN_WIDTH] = color;
+        dst[4 * SCREEN_WIDTH] = color;
+        dst[5 * SCREEN_WIDTH] = color;
+        dst[6 * SCREEN_WIDTH] = color;
+        dst[7 * SCREEN_WIDTH] = color;
+        dst += 8 * SCREEN_WIDTH;
+        count -= 8;
+    }
+    while (count > 0) {
+        *dst = color;
+        dst += SCREEN_WIDTH;
+        count--;
+    }
+    return dst;
+}
+
+static uint8_t *fill_wide(uint8_t *dst, int count, int width, uint8_t color) {
+    for (; count > 0; count--) {
+        memset(dst, color, width);
+        dst += SCREEN_WIDTH;
+    }
+    return dst;
+}
+
+void blit_begin(uint8_t clear_color) {
+    (void)clear_color;
+    memset(&gfx_vbuffer[0][0], view_border, view_top * SCREEN_WIDTH);
+    memset(&gfx_vbuffer[0][0] + view_bottom * SCREEN_WIDTH, view_border, (SCREEN_HEIGHT - view_bottom) * SCREEN_WIDTH);
+}
+
+void blit_column(int x, int width, int wall_start, int wall_end,
+                 uint8_t ceiling_color, uint8_t wall_color, uint8_t floor_color) {
+    int floor_start = (wall_end >= wall_start) ? wall_end + 1 : wall_start;
+    int ceiling_rows = wall_start - view_top;
+    int wall_rows = floor_start - wall_start;
+    int floor_rows = view_bottom - floor_start;
+    uint8_t *top = &gfx_vbuffer[view_top][x];
+
+    if (width >= WIDE_SPAN_MIN) {
+        uint8_t *dst = fill_wide(top, ceiling_rows, width, ceiling_color);
+        dst = fill_wide(dst, wall_rows, width, wall_color);
+        fill_wide(dst, floor_rows, width, floor_color);
+        return;
+    }
+
+    for (int col = 0; col < width; col++) {
+        uint8_t *dst = fill_strided(top + col, ceiling_rows, ceiling_color);
+        dst = fill_strided(dst, wall_rows, wall_color);
+        fill_strided(dst, floor_rows, floor_color);
+    }
+}
+
+void blit_textured_column(int x, int width, int wall_start, int wall_end,
+                          uint8_t ceiling_color, uint8_t floor_color,
+                          const uint8_t *texels, const uint8_t *colors, int pos, int step) {
+    int floor_start = (wall_end >= wall_start) ? wall_end + 1 : wall_start;
+    uint8_t *dst = &gfx_vbuffer[view_top][x];
+
+    if (width == 1) {
+        dst = fill_strided(dst, wall_start - view_top, ceiling_color);
+        for (int rows = floor_start - wall_start; rows > 0; rows--) {
+            *dst = colors[texels[pos >> TEX_STEP_SHIFT]];
+            dst += SCREEN_WIDTH;
+            pos += step;
+        }
+        fill_strided(dst, view_bottom - floor_start, floor_color);
+        return;
+    }
+
+    dst = fill_wide(dst, wall_start - view_top, width, ceiling_color);
+    for (int rows = floor_start - wall_start; rows > 0; rows--) {
+        memset(dst, colors[texels[pos >> TEX_STEP_SHIFT]], width);
+        dst += SCREEN_WIDTH;
+        pos += step;
+    }
+    fill_wide(dst, view_bottom - floor_start, width, floor_color);
+}
+#endif
+
+#if BLIT_COLUMN_MAJOR
+static bool clip_rect(int *x, int *y, int *width, int *height) {
+    if (*x < 0) {
+        *width += *x;
+        *x = 0;
+    }
+    if (*y < 0) {
+        *height += *y;
+        *y = 0;
+    }
+    if (*x + *width > SCREEN_WIDTH) *width = SCREEN_WIDTH - *x;
+    if (*y + *height > SCREEN_HEIGHT) *height = SCREEN_HEIGHT - *y;
+    return *width > 0 && *height > 0;
+}
+
+void blit_init(void) {
+    lcd_set_column_major(true);
+}
+
+void blit_cleanup(void) {
+    lcd_set_column_major(false);
+}
+
+void blit_fill_rect(int x, int y, int width, int height, uint8_t color) {
+    if (!clip_rect(&x, &y, &width, &height)) {
+        return;
+    }
+    for (int col = x; col < x + width; col++) {
+        memset(&FRAMEBUFFER[col][y], color, height);
+    }
+}
+
+void blit_hline(int x, int y, int length, uint8_t color) {
+    int height = 1;
+    if (!clip_rect(&x, &y, &length, &height)) {
+        return;
+    }
+    uint8_t *dst = &FRAMEBUFFER[x][y];
+    for (; length > 0; length--) {
+        *dst = color;
+        dst += SCREEN_HEIGHT;
+    }
+}
+
+void blit_vline(int x, int y, int length, uint8_t color) {
+    blit_fill_rect(x, y, 1, length, color);
+}
+
+void blit_pixel(int x, int y, uint8_t color) {
+    if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
+        FRAMEBUFFER[x][y] = color;
+    }
+}
+
+void blit_rect(int x, int y, int width, int height, uint8_t color) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    blit_hline(x, y, width, color);
+    blit_hline(x, y + height - 1, width, color);
+    blit_vline(x, y, height, color);
+    blit_vline(x + width - 1, y, height, color);
+}
+#else
+void blit_init(void) {
+}
+
+void blit_cleanup(void) {
+}
+
+void blit_fill_rect(int x, int y, int width, int height, uint8_t color) {
+    gfx_SetColor(color);
+    gfx_FillRectangle(x, y, width, height);
+}
+
+void blit_hline(int x, int y, int length, uint8_t color) {
+    gfx_SetColor(color);
+    gfx_HorizLine(x, y, length);
+}
+
+void blit_vline(int x, int y, int length, uint8_t color) {
+    gfx_SetColor(color);
+    gfx_VertLine(x, y, length);
+}
+
+void blit_pixel(int x, int y, uint8_t color) {
+    gfx_SetColor(color);
+    gfx_SetPixel(x, y);
+}
+
+void blit_rect(int x, int y, int width, int height, uint8_t color) {
+    gfx_SetColor(color);
+    gfx_Rectangle(x, y, width, height);
+}
+#endif
+
+/* Clips a column of count texels, each repeated zoom times from row y, to the view; returns the rows left. */
+static int clip_sprite_column(int *y, const uint8_t **texels, int count, int zoom, int *repeat) {
+    int end = *y + count * zoom;
+    if (end > view_bottom) end = view_bottom;
+    *repeat = zoom;
+    if (*y < view_top) {
+        int skip = view_top - *y;
+        *texels += skip / zoom;
+        *repeat = zoom - skip % zoom;
+        *y = view_top;
+    }
+    return end - *y;
+}
+
+#if BLIT_USE_GRAPHX
+void blit_sprite_column(int x, int width, int y, const uint8_t *texels, int count, int zoom) {
+    int repeat;
+    int rows = clip_sprite_column(&y, &texels, count, zoom, &repeat);
+    int start = 0;
+    uint8_t color = 0;
+
+    for (int row = 0; row <= rows; row++) {
+        uint8_t texel = (row < rows) ? *texels : 0;
+        if (texel != color) {
+            if (color) {
+                gfx_SetColor(color);
+                gfx_FillRectangle(x, y + start, width, row - start);
+            }
+            color = texel;
+            start = row;
+        }
+        if (--repeat == 0) {
+            texels++;
+            repeat = zoom;
+        }
+    }
+}
+#elif BLIT_COLUMN_MAJOR
+void blit_sprite_column(int x, int width, int y, const uint8_t *texels, int count, int zoom) {
+    int first_repeat;
+    int rows = clip_sprite_column(&y, &texels, count, zoom, &first_repeat);
+
+    for (int col = x; col < x + width; col++) {
+        const uint8_t *src = texels;
+        int repeat = first_repeat;
+        uint8_t *dst = &FRAMEBUFFER[col][y];
+        for (int n = rows; n > 0; n--) {
+            if (*src) {
+                *dst = *src;
+            }
+            dst++;
+            if (--repeat == 0) {
+                src++;
+                repeat = zoom;
+            }
+        }
+    }
+}
+#else
+void blit_sprite_column(int x, int width, int y, const uint8_t *texels, int count, int zoom) {
+    int repeat;
+    int rows = clip_sprite_column(&y, &texels, count, zoom, &repeat);
+    uint8_t *dst = &gfx_vbuffer[y][x];
+
+    for (; rows > 0; rows--) {
+        if (*texels) {
+            if (width == 1) {
+                *dst = *texels;
+            } else {
+                memset(dst, *texels, width);
+            }
+        }
+        dst += SCREEN_WIDTH;
+        if (--repeat == 0) {
+            texels++;
+            repeat = zoom;
+        }
+    }
+}
+#endif
@@ -0,0 +1,35 @@
+#ifndef BLIT_H
+#define BLIT_H
+
+#include <stdint.h>
+
+#ifndef BLIT_USE_GRAPHX
+#define BLIT_USE_GRAPHX 0
+#endif
+
+#ifndef BLIT_COLUMN_MAJOR
+#define BLIT_COLUMN_MAJOR 0
+#endif
+
+#if BLIT_USE_GRAPHX && BLIT_COLUMN_MAJOR
+#error "BLIT_COLUMN_MAJOR needs the framebuffer back end"
+#endif
+
+void blit_init(void);
+void blit_cleanup(void);
+void blit_set_view(int top, int bottom, uint8_t border_color);
+void blit_begin(uint8_t clear_color);
+void blit_column(int x, int width, int wall_start, int wall_end,
+                 uint8_t ceiling_color, uint8_t wall_color, uint8_t floor_color);
+void blit_textured_column(int x, int width, int wall_start, int wall_end,
+                          uint8_t ceiling_color, uint8_t floor_color,
+                          const uint8_t *texels, const uint8_t *colors, int pos, int step);
+
+void blit_fill_rect(int x, int y, int width, int height, uint8_t color);
+void blit_rect(int x, int y, int width, int height, uint8_t color);
+void blit_hline(int x, int y, int length, uint8_t color);
+void blit_vline(int x, int y, int length, uint8_t color);
+void blit_pixel(int x, int y, uint8_t color);
+void blit_sprite_column(int x, int width, int y, const uint8_t *texels, int count, int zoom);
+
+#endif
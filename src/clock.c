@@ -0,0 +1,12 @@
+#include "clock.h"
+#include <sys/timers.h>
+
+void clock_init(void) {
+    timer_Disable(1);
+    timer_Set(1, 0);
+    timer_Enable(1, TIMER_32K, TIMER_NOINT, TIMER_UP);
+}
+
+uint32_t clock_now(void) {
+    return timer_Get(1);
+}
@@ -0,0 +1,11 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#define CLOCK_HZ 32768
+
+void clock_init(void);
+uint32_t clock_now(void);
+
+#endif
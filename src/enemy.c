@@ -1,7 +1,7 @@
 #include "enemy.h"
 #include "player.h"
 #include "level.h"
-#include <math.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
@@ -13,30 +13,131 @@ static uint32_t enemy_rng_next(void) {
     return (enemy_rng_state >> 16) & 0x7FFF;
 }
 
-static enemy_t enemies[MAX_ENEMIES];
+#if MAX_ENEMIES > 255
+#error "enemy indices are stored in uint8_t"
+#endif
+
+#define BUCKET_SHIFT 2
+#define BUCKET_COLS ((MAP_WIDTH + (1 << BUCKET_SHIFT) - 1) >> BUCKET_SHIFT)
+#define BUCKET_ROWS ((MAP_HEIGHT + (1 << BUCKET_SHIFT) - 1) >> BUCKET_SHIFT)
+#define BUCKET_COUNT (BUCKET_COLS * BUCKET_ROWS)
+#define ENEMY_NONE 0xFF
+
+static enemy_list_t enemies;
 static int enemy_count = 0;
 
-static const int enemy_hp[] = {20, 40, 80};
-static const float enemy_speed[] = {0.03, 0.02, 0.015};
-static const float enemy_damage[] = {5, 10, 15};
-static const float enemy_range[] = {8.0, 10.0, 12.0};
+/* Each live enemy is linked into one bucket per 4x4 cells. */
+static uint8_t bucket_head[BUCKET_COUNT];
+static uint8_t bucket_next[MAX_ENEMIES];
+static uint16_t enemy_bucket[MAX_ENEMIES];
+static uint8_t nearby[MAX_ENEMIES];
+
+static const uint8_t enemy_hp[] = {20, 40, 80};
+/* Cells per tick in 8.8: about 0.03, 0.02 and 0.015. */
+static const uint8_t enemy_speed[] = {8, 5, 4};
+static const uint8_t enemy_damage[] = {5, 10, 15};
+static const uint8_t enemy_range[] = {8, 10, 12};
+
+#define SHOT_CONE (ANGLE_STEPS / 6)
+#define SHOT_RANGE FIXED_FROM_INT(8)
+#define SHOT_DAMAGE 10
+#define MELEE_RANGE_SQ ((int32_t)FIXED_ONE * FIXED_ONE)
+#define CHASE_MIN_SQ ((int32_t)(FIXED_ONE * 3 / 10) * (FIXED_ONE * 3 / 10))
+#define ATTACK_TICKS 3
+
+static inline int32_t dist_sq(int dx, int dy) {
+    return (int32_t)dx * dx + (int32_t)dy * dy;
+}
+
+static inline int bucket_coord(fixed_t v, int limit) {
+    int b = (v < 0) ? 0 : v >> (FIXED_SHIFT + BUCKET_SHIFT);
+    return (b < limit) ? b : limit - 1;
+}
+
+static inline int bucket_of(int i) {
+    return bucket_coord(enemies.y[i], BUCKET_ROWS) * BUCKET_COLS + bucket_coord(enemies.x[i], BUCKET_COLS);
+}
 
-static void spawn_enemy(float x, float y, enemy_type_t type) {
+static void bucket_link(int i) {
+    int b = bucket_of(i);
+    enemy_bucket[i] = (uint16_t)b;
+    bucket_next[i] = bucket_head[b];
+    bucket_head[b] = (uint8_t)i;
+}
+
+static void bucket_unlink(int i) {
+    uint8_t *link = &bucket_head[enemy_bucket[i]];
+    while (*link != i) {
+        link = &bucket_next[*link];
+    }
+    *link = bucket_next[i];
+}
+
+static void bucket_move(int i) {
+    if (bucket_of(i) != enemy_bucket[i]) {
+        bucket_unlink(i);
+        bucket_link(i);
+    }
+}
+
+static void enemy_copy(int dst, int src) {
+    enemies.x[dst] = enemies.x[src];
+    enemies.y[dst] = enemies.y[src];
+    enemies.prev_x[dst] = enemies.prev_x[src];
+    enemies.prev_y[dst] = enemies.prev_y[src];
+    enemies.view_x[dst] = enemies.view_x[src];
+    enemies.view_y[dst] = enemies.view_y[src];
+    enemies.angle[dst] = enemies.angle[src];
+    enemies.type[dst] = enemies.type[src];
+    enemies.hp[dst] = enemies.hp[src];
+    enemies.attack_ticks[dst] = enemies.attack_ticks[src];
+    enemies.zone[dst] = enemies.zone[src];
+    enemies.zone_x[dst] = enemies.zone_x[src];
+    enemies.zone_y[dst] = enemies.zone_y[src];
+}
+
+/* Swap-remove: the last enemy takes slot i, so indices above i are invalidated. */
+static void enemy_remove(int i) {
+    int last = enemy_count - 1;
+    bucket_unlink(i);
+    if (i != last) {
+        bucket_unlink(last);
+        enemy_copy(i, last);
+        bucket_link(i);
+    }
+    enemy_count = last;
+}
+
+static void sort_indices(uint8_t *out, int count) {
+    for (int i = 1; i < count; i++) {
+        uint8_t v = out[i];
+        int j = i;
+        while (j > 0 && out[j - 1] > v) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = v;
+    }
+}
+
+static void spawn_enemy(int x, int y, enemy_type_t type) {
     if (enemy_count >= MAX_ENEMIES) return;
 
-    enemy_t* e = &enemies[enemy_count++];
-    e->x = x;
-    e->y = y;
-    e->angle = 0.0;
-    e->type = type;
-    e->hp = enemy_hp[type];
-    e->max_hp = enemy_hp[type];
-    e->active = true;
-    e->move_timer = 0.0;
+    int i = enemy_count++;
+    enemies.x[i] = enemies.prev_x[i] = enemies.view_x[i] = (uint16_t)x;
+    enemies.y[i] = enemies.prev_y[i] = enemies.view_y[i] = (uint16_t)y;
+    enemies.angle[i] = 0;
+    enemies.type[i] = (uint8_t)type;
+    enemies.hp[i] = enemy_hp[type];
+    enemies.attack_ticks[i] = 0;
+    enemies.zone_x[i] = ENEMY_ZONE_UNKNOWN;
+    enemies.zone_y[i] = ENEMY_ZONE_UNKNOWN;
+    bucket_link(i);
 }
 
 void enemy_init(void) {
-    memset(enemies, 0, sizeof(enemies));
+    memset(&enemies, 0, sizeof(enemies));
+    memset(bucket_head, ENEMY_NONE, sizeof(bucket_head));
     enemy_count = 0;
 
     enemy_rng_state = level_get_rng();
@@ -51,12 +152,12 @@ void enemy_init(void) {
             int room_w = rooms[i].w - 2;
             int room_h = rooms[i].h - 2;
             if (room_w > 0 && room_h > 0) {
-                float spawn_x = rooms[i].x + 1.0 + (enemy_rng_next() % room_w);
-                float spawn_y = rooms[i].y + 1.0 + (enemy_rng_next() % room_h);
+                int spawn_x = rooms[i].x + 1 + (enemy_rng_next() % room_w);
+                int spawn_y = rooms[i].y + 1 + (enemy_rng_next() % room_h);
 
                 enemy_type_t type = (enemy_type_t)(enemy_rng_next() % 3);
 
-                spawn_enemy(spawn_x, spawn_y, type);
+                spawn_enemy(FIXED_FROM_INT(spawn_x), FIXED_FROM_INT(spawn_y), type);
             }
         }
     }
@@ -64,100 +165,164 @@ void enemy_init(void) {
     if (enemy_count == 0 && room_count > 2) {
         int mid_room = room_count / 2;
         if (mid_room > 0 && mid_room < room_count - 1) {
-            spawn_enemy(rooms[mid_room].center_x + 0.5,
-                       rooms[mid_room].center_y + 0.5, ENEMY_TYPE_IMP);
+            spawn_enemy(FIXED_FROM_INT(rooms[mid_room].center_x) + FIXED_ONE / 2,
+                        FIXED_FROM_INT(rooms[mid_room].center_y) + FIXED_ONE / 2, ENEMY_TYPE_IMP);
         }
     }
 }
 
 void enemy_update_all(void) {
-    float px = player_get_x();
-    float py = player_get_y();
-
-    for (int i = 0; i < enemy_count; i++) {
-        enemy_t* e = &enemies[i];
-        if (!e->active) continue;
-
-        float dx = px - e->x;
-        float dy = py - e->y;
-        float dist_sq = dx * dx + dy * dy;
-        float dist = sqrtf(dist_sq);
-
-        e->angle = atan2f(dy, dx);
-
-        float range_sq = enemy_range[e->type] * enemy_range[e->type];
-        if (dist_sq < range_sq && dist > 0.3f) {
-            float speed = enemy_speed[e->type];
-            float cos_angle = cosf(e->angle);
-            float sin_angle = sinf(e->angle);
-            float new_x = e->x + cos_angle * speed;
-            float new_y = e->y + sin_angle * speed;
-
-            int new_xi = (int)new_x;
-            int new_yi = (int)new_y;
-            if (new_x < 0.0f) new_xi--;
-            if (new_y < 0.0f) new_yi--;
-
-            if (!level_is_wall(new_xi, new_yi)) {
-                e->x = new_x;
-                e->y = new_y;
+    fixed_t px = FIXED_FROM_FLOAT(player_get_x());
+    fixed_t py = FIXED_FROM_FLOAT(player_get_y());
+    int player_zone = player_get_zone();
+    int count = enemy_query_radius(px, py, ENEMY_ACTIVE_RADIUS, nearby, MAX_ENEMIES);
+
+    for (int n = 0; n < count; n++) {
+        int i = nearby[n];
+        int type = enemies.type[i];
+        fixed_t x = enemies.x[i];
+        fixed_t y = enemies.y[i];
+
+        enemies.prev_x[i] = (uint16_t)x;
+        enemies.prev_y[i] = (uint16_t)y;
+
+        int dx = px - x;
+        int dy = py - y;
+        int32_t d_sq = dist_sq(dx, dy);
+
+        angle_t angle = angle_atan2(dy, dx);
+        enemies.angle[i] = angle;
+
+        int32_t range_sq = dist_sq(FIXED_FROM_INT(enemy_range[type]), 0);
+        bool sees = level_zone_sees(enemy_get_zone(i), player_zone);
+        if (sees && d_sq < range_sq && d_sq > CHASE_MIN_SQ) {
+            fixed_t new_x = x + ((angle_cos(angle) * enemy_speed[type] + TRIG_ONE / 2) >> TRIG_SHIFT);
+            fixed_t new_y = y + ((angle_sin(angle) * enemy_speed[type] + TRIG_ONE / 2) >> TRIG_SHIFT);
+
+            if (!level_is_wall(FIXED_TO_INT(new_x), FIXED_TO_INT(new_y))) {
+                enemies.x[i] = (uint16_t)new_x;
+                enemies.y[i] = (uint16_t)new_y;
+                bucket_move(i);
             }
         }
 
-        if (dist < 1.0) {
-            e->move_timer += 0.2;
-            if (e->move_timer > 0.5) {
-                player_take_damage((int)enemy_damage[e->type]);
-                e->move_timer = 0.0;
+        if (d_sq < MELEE_RANGE_SQ) {
+            if (++enemies.attack_ticks[i] >= ATTACK_TICKS) {
+                player_take_damage(enemy_damage[type]);
+                enemies.attack_ticks[i] = 0;
             }
         } else {
-            e->move_timer = 0.0;
+            enemies.attack_ticks[i] = 0;
         }
     }
 }
 
 void enemy_check_shots(void) {
-    float px = player_get_x();
-    float py = player_get_y();
-    float pangle = player_get_angle();
-
-    for (int i = 0; i < enemy_count; i++) {
-        enemy_t* e = &enemies[i];
-        if (!e->active) continue;
-
-        float dx = e->x - px;
-        float dy = e->y - py;
-        float dist_sq = dx * dx + dy * dy;
-
-        if (dist_sq < 64.0f) {
-            float angle_to_enemy = atan2f(dy, dx);
-            float angle_diff = angle_to_enemy - pangle;
-
-            while (angle_diff > M_PI) angle_diff -= 2 * M_PI;
-            while (angle_diff < -M_PI) angle_diff += 2 * M_PI;
-
-            if (fabsf(angle_diff) < M_PI / 3.0f) {
-                e->hp -= 10;
-                if (e->hp <= 0) {
-                    e->active = false;
-                    if ((enemy_rng_next() % 3) == 0) {
-                        player_add_ammo(5);
-                    }
-                }
-            }
+    fixed_t px = FIXED_FROM_FLOAT(player_get_x());
+    fixed_t py = FIXED_FROM_FLOAT(player_get_y());
+    angle_t pangle = player_get_angle();
+    int player_zone = player_get_zone();
+    int count = enemy_query_cone(px, py, pangle, SHOT_CONE, SHOT_RANGE, nearby, MAX_ENEMIES);
+    sort_indices(nearby, count);
+
+    /* Highest index first, so a swap-remove never moves an enemy still to be visited. */
+    for (int n = count - 1; n >= 0; n--) {
+        int i = nearby[n];
+        if (!level_zone_sees(player_zone, enemy_get_zone(i))) continue;
+
+        if (enemies.hp[i] > SHOT_DAMAGE) {
+            enemies.hp[i] -= SHOT_DAMAGE;
+            continue;
+        }
+        enemy_remove(i);
+        if ((enemy_rng_next() % 3) == 0) {
+            player_add_ammo(5);
         }
     }
 }
 
+void enemy_interpolate(int alpha) {
+    fixed_t px = FIXED_FROM_FLOAT(player_get_x());
+    fixed_t py = FIXED_FROM_FLOAT(player_get_y());
+    int count = enemy_query_radius(px, py, ENEMY_ACTIVE_RADIUS, nearby, MAX_ENEMIES);
+
+    for (int n = 0; n < count; n++) {
+        int i = nearby[n];
+        int prev_x = enemies.prev_x[i];
+        int prev_y = enemies.prev_y[i];
+        enemies.view_x[i] = (uint16_t)(prev_x + (((enemies.x[i] - prev_x) * alpha) >> LERP_SHIFT));
+        enemies.view_y[i] = (uint16_t)(prev_y + (((enemies.y[i] - prev_y) * alpha) >> LERP_SHIFT));
+    }
+}
+
 void enemy_cleanup(void) {
     enemy_count = 0;
 }
 
+/* Indices of enemies strictly within radius of (x, y), in bucket order; visits only the buckets the circle overlaps. */
+int enemy_query_radius(fixed_t x, fixed_t y, fixed_t radius, uint8_t *out, int max) {
+    int bx0 = bucket_coord(x - radius, BUCKET_COLS);
+    int bx1 = bucket_coord(x + radius, BUCKET_COLS);
+    int by0 = bucket_coord(y - radius, BUCKET_ROWS);
+    int by1 = bucket_coord(y + radius, BUCKET_ROWS);
+    int32_t radius_sq = dist_sq(radius, 0);
+    int count = 0;
+
+    for (int by = by0; by <= by1; by++) {
+        for (int bx = bx0; bx <= bx1; bx++) {
+            for (int i = bucket_head[by * BUCKET_COLS + bx]; i != ENEMY_NONE; i = bucket_next[i]) {
+                if (dist_sq(enemies.x[i] - x, enemies.y[i] - y) < radius_sq && count < max) {
+                    out[count++] = (uint8_t)i;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+/* Radius query narrowed to enemies whose bearing from (x, y) is strictly within half_angle of angle. */
+int enemy_query_cone(fixed_t x, fixed_t y, angle_t angle, int half_angle, fixed_t radius, uint8_t *out, int max) {
+    int found = enemy_query_radius(x, y, radius, out, max);
+    int count = 0;
+    for (int n = 0; n < found; n++) {
+        int i = out[n];
+        angle_t bearing = angle_atan2(enemies.y[i] - y, enemies.x[i] - x);
+        int diff = angle_diff(bearing, angle);
+        if (diff > -half_angle && diff < half_angle) {
+            out[count++] = (uint8_t)i;
+        }
+    }
+    return count;
+}
+
+int enemy_query_cell(int x, int y, uint8_t *out, int max) {
+    if (x < 0 || y < 0 || x >= MAP_WIDTH || y >= MAP_HEIGHT) {
+        return 0;
+    }
+    int count = 0;
+    for (int i = bucket_head[(y >> BUCKET_SHIFT) * BUCKET_COLS + (x >> BUCKET_SHIFT)]; i != ENEMY_NONE; i = bucket_next[i]) {
+        if (FIXED_TO_INT(enemies.x[i]) == x && FIXED_TO_INT(enemies.y[i]) == y && count < max) {
+            out[count++] = (uint8_t)i;
+        }
+    }
+    return count;
+}
+
+int enemy_get_zone(int i) {
+    int x = FIXED_TO_INT(enemies.x[i]);
+    int y = FIXED_TO_INT(enemies.y[i]);
+    if (x != enemies.zone_x[i] || y != enemies.zone_y[i]) {
+        enemies.zone_x[i] = (uint8_t)x;
+        enemies.zone_y[i] = (uint8_t)y;
+        enemies.zone[i] = (int16_t)level_zone_at(x, y);
+    }
+    return enemies.zone[i];
+}
+
 int enemy_get_count(void) {
     return enemy_count;
 }
 
-enemy_t* enemy_get_list(void) {
-    return enemies;
+const enemy_list_t *enemy_get_list(void) {
+    return &enemies;
 }
-
@@ -1,31 +1,52 @@
 #ifndef ENEMY_H
 #define ENEMY_H
 
-#include <stdbool.h>
+#include <stdint.h>
+#include "angle.h"
+#include "fixed.h"
 
-#define MAX_ENEMIES 32
+#define MAX_ENEMIES 128
+/* Covers the 20-cell view distance plus a tick of player movement. */
+#define ENEMY_ACTIVE_RADIUS FIXED_FROM_INT(22)
+#define ENEMY_ZONE_UNKNOWN 0xFF
 
 typedef enum {
     ENEMY_TYPE_IMP,
     ENEMY_TYPE_DEMON,
-    ENEMY_TYPE_BARON
+    ENEMY_TYPE_BARON,
+    ENEMY_TYPE_COUNT
 } enemy_type_t;
 
+/*
+ * Live enemies, one parallel array per field, dense in [0, count): a kill
+ * swap-removes so loops never meet a dead slot. Positions are 8.8 cells.
+ */
 typedef struct {
-    float x, y;
-    float angle;
-    enemy_type_t type;
-    int hp;
-    int max_hp;
-    bool active;
-    float move_timer;
-} enemy_t;
+    uint16_t x[MAX_ENEMIES];
+    uint16_t y[MAX_ENEMIES];
+    uint16_t prev_x[MAX_ENEMIES];
+    uint16_t prev_y[MAX_ENEMIES];
+    uint16_t view_x[MAX_ENEMIES];
+    uint16_t view_y[MAX_ENEMIES];
+    angle_t angle[MAX_ENEMIES];
+    uint8_t type[MAX_ENEMIES];
+    uint8_t hp[MAX_ENEMIES];
+    uint8_t attack_ticks[MAX_ENEMIES];
+    int16_t zone[MAX_ENEMIES];
+    uint8_t zone_x[MAX_ENEMIES];
+    uint8_t zone_y[MAX_ENEMIES];
+} enemy_list_t;
 
 void enemy_init(void);
 void enemy_update_all(void);
 void enemy_cleanup(void);
 void enemy_check_shots(void);
+void enemy_interpolate(int alpha);
 int enemy_get_count(void);
-enemy_t* enemy_get_list(void);
+const enemy_list_t *enemy_get_list(void);
+int enemy_get_zone(int i);
+int enemy_query_radius(fixed_t x, fixed_t y, fixed_t radius, uint8_t *out, int max);
+int enemy_query_cone(fixed_t x, fixed_t y, angle_t angle, int half_angle, fixed_t radius, uint8_t *out, int max);
+int enemy_query_cell(int x, int y, uint8_t *out, int max);
 
 #endif
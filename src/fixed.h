@@ -0,0 +1,37 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+/*
+ * fixed_t is 16.8 in a plain int (24 bits on the CE); trig_t is 2.14.
+ * Ray distances use the finer RAY_SHIFT scale.
+ */
+
+#define FIXED_SHIFT 8
+#define FIXED_ONE (1 << FIXED_SHIFT)
+#define FIXED_FRAC_MASK (FIXED_ONE - 1)
+
+#define RAY_SHIFT 12
+#define RAY_ONE (1 << RAY_SHIFT)
+
+#define TRIG_SHIFT 14
+#define TRIG_ONE (1 << TRIG_SHIFT)
+
+#define LERP_SHIFT 8
+#define LERP_ONE (1 << LERP_SHIFT)
+
+typedef int fixed_t;
+typedef int16_t trig_t;
+
+#define FIXED_FROM_INT(i) ((fixed_t)(i) << FIXED_SHIFT)
+#define FIXED_TO_INT(f) ((int)((f) >> FIXED_SHIFT))
+#define FIXED_FROM_FLOAT(f) ((fixed_t)((f) * (float)FIXED_ONE))
+#define FIXED_TO_FLOAT(f) ((float)(f) / (float)FIXED_ONE)
+#define TRIG_FROM_FLOAT(f) ((trig_t)((f) * (float)TRIG_ONE))
+
+static inline fixed_t fixed_mul(fixed_t a, fixed_t b) {
+    return (fixed_t)(((int32_t)a * b) >> FIXED_SHIFT);
+}
+
+#endif
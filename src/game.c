@@ -4,17 +4,15 @@
 #include "enemy.h"
 #include "ui.h"
 #include "raycast.h"
-#include <keypadc.h>
-#include <time.h>
+#include "input.h"
+#include "profile.h"
 
 static bool running = false;
 static bool initialized = false;
 
-void game_init(void) {
+void game_init(uint32_t seed) {
     if (initialized) return;
 
-    time_t t = time(NULL);
-    uint32_t seed = (uint32_t)t;
     if (seed == 0) seed = 12345;
 
     level_init(seed);
@@ -22,6 +20,7 @@ void game_init(void) {
     enemy_init();
     ui_init();
     raycast_init();
+    input_init();
 
     running = true;
     initialized = true;
@@ -30,14 +29,22 @@ void game_init(void) {
 void game_update(void) {
     if (!running) return;
 
-    kb_Scan();
-    if (kb_Data[6] & kb_Clear) {
+    input_tick();
+    if (input_down(INPUT_QUIT)) {
         running = false;
         return;
     }
+    if (input_pressed(INPUT_PROFILE)) {
+        PROFILE_TOGGLE_OVERLAY();
+    }
 
+    PROFILE_BEGIN(PROFILE_PLAYER);
     player_update();
+    PROFILE_END(PROFILE_PLAYER);
+
+    PROFILE_BEGIN(PROFILE_ENEMY_AI);
     enemy_update_all();
+    PROFILE_END(PROFILE_ENEMY_AI);
 
     if (level_is_at_exit(player_get_x(), player_get_y())) {
         running = false;
@@ -48,13 +55,27 @@ void game_update(void) {
     }
 }
 
-void game_render(void) {
+/* alpha is how far the clock has run into the next tick, 0..LERP_ONE. */
+void game_render(int alpha) {
     if (!running) return;
 
+    player_interpolate(alpha);
+    enemy_interpolate(alpha);
+
+    PROFILE_BEGIN(PROFILE_RAYCAST);
     raycast_render();
+    PROFILE_END(PROFILE_RAYCAST);
+
+    PROFILE_BEGIN(PROFILE_SPRITES);
     raycast_render_enemies();
+    PROFILE_END(PROFILE_SPRITES);
+
+    PROFILE_BEGIN(PROFILE_UI);
     ui_render();
     ui_render_crosshair();
+    PROFILE_END(PROFILE_UI);
+
+    PROFILE_DRAW_OVERLAY();
 }
 
 void game_cleanup(void) {
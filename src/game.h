@@ -2,10 +2,11 @@
 #define GAME_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
-void game_init(void);
+void game_init(uint32_t seed);
 void game_update(void);
-void game_render(void);
+void game_render(int alpha);
 void game_cleanup(void);
 bool game_is_running(void);
 
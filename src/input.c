@@ -0,0 +1,106 @@
+#include "input.h"
+#include "clock.h"
+#include "replay.h"
+#include <keypadc.h>
+
+typedef struct {
+    uint8_t group;
+    uint8_t mask;
+} key_binding_t;
+
+static const key_binding_t bindings[INPUT_KEY_COUNT] = {
+    [INPUT_UP] = { 7, kb_Up },
+    [INPUT_DOWN] = { 7, kb_Down },
+    [INPUT_LEFT] = { 7, kb_Left },
+    [INPUT_RIGHT] = { 7, kb_Right },
+    [INPUT_FIRE] = { 1, kb_2nd },
+    [INPUT_QUIT] = { 6, kb_Clear },
+    [INPUT_PROFILE] = { 1, kb_Mode }
+};
+
+static uint8_t live_keys = 0;
+static uint8_t latched_keys = 0;
+static uint8_t current_keys = 0;
+static uint8_t previous_keys = 0;
+
+static bool press_waiting = false;
+static bool press_ticked = false;
+static uint32_t press_time = 0;
+static uint32_t latency = 0;
+static uint32_t max_latency = 0;
+
+void input_init(void) {
+    live_keys = 0;
+    latched_keys = 0;
+    current_keys = 0;
+    previous_keys = 0;
+    press_waiting = false;
+    press_ticked = false;
+    latency = 0;
+    max_latency = 0;
+}
+
+/* The only kb_Scan() in the game; presses seen here are held until the next tick. */
+void input_poll(void) {
+    kb_Scan();
+
+    uint8_t keys = 0;
+    for (int i = 0; i < INPUT_KEY_COUNT; i++) {
+        if (kb_Data[bindings[i].group] & bindings[i].mask) {
+            keys |= (uint8_t)(1 << i);
+        }
+    }
+
+    if ((keys & ~live_keys) && !press_waiting) {
+        press_waiting = true;
+        press_ticked = false;
+        press_time = clock_now();
+    }
+
+    live_keys = keys;
+    latched_keys |= keys;
+}
+
+void input_tick(void) {
+    previous_keys = current_keys;
+    current_keys = replay_filter((uint8_t)(live_keys | latched_keys));
+    latched_keys = 0;
+
+    if (press_waiting) {
+        press_ticked = true;
+    }
+}
+
+/* Call after each buffer swap; closes out a pending key-down latency sample. */
+void input_frame_shown(uint32_t now) {
+    if (!press_ticked) {
+        return;
+    }
+
+    latency = now - press_time;
+    if (latency > max_latency) {
+        max_latency = latency;
+    }
+    press_waiting = false;
+    press_ticked = false;
+}
+
+bool input_down(input_key_t key) {
+    return (current_keys >> key) & 1;
+}
+
+bool input_pressed(input_key_t key) {
+    return ((current_keys & ~previous_keys) >> key) & 1;
+}
+
+bool input_released(input_key_t key) {
+    return ((previous_keys & ~current_keys) >> key) & 1;
+}
+
+uint32_t input_get_latency(void) {
+    return latency;
+}
+
+uint32_t input_get_max_latency(void) {
+    return max_latency;
+}
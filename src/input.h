@@ -0,0 +1,30 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    INPUT_UP,
+    INPUT_DOWN,
+    INPUT_LEFT,
+    INPUT_RIGHT,
+    INPUT_FIRE,
+    INPUT_QUIT,
+    INPUT_PROFILE,
+    INPUT_KEY_COUNT
+} input_key_t;
+
+void input_init(void);
+void input_poll(void);
+void input_tick(void);
+void input_frame_shown(uint32_t now);
+
+bool input_down(input_key_t key);
+bool input_pressed(input_key_t key);
+bool input_released(input_key_t key);
+
+uint32_t input_get_latency(void);
+uint32_t input_get_max_latency(void);
+
+#endif
@@ -0,0 +1,67 @@
+#include "lcd.h"
+#include <stdint.h>
+
+/*
+ * The panel controller sits behind the SPI port and takes 9-bit frames,
+ * pushed into the FIFO as three bytes with bit 8 (data/command) in the
+ * second byte. Setting MV in MADCTL makes the panel fill its RAM along
+ * the 240-pixel axis, so the 320x240 stream from the LCD controller
+ * lands on screen one column at a time.
+ */
+
+#define SPI_CTRL2 (*(volatile uint8_t *)0xF80808)
+#define SPI_STATUS (*(volatile uint24_t *)0xF8080C)
+#define SPI_FIFO (*(volatile uint8_t *)0xF80818)
+
+#define SPI_CTRL2_TX_ENABLE 0x01
+#define SPI_STATUS_TX_LEVEL 0x1F000
+#define SPI_STATUS_BUSY 0x04
+
+#define LCD_CMD_CASET 0x2A
+#define LCD_CMD_RASET 0x2B
+#define LCD_CMD_MADCTL 0x36
+
+#define LCD_MADCTL_ROW_MAJOR 0x08
+#define LCD_MADCTL_COLUMN_MAJOR 0x28
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 240
+
+static void spi_write(bool data, uint8_t value) {
+    SPI_FIFO = 0;
+    SPI_FIFO = data ? 1 : 0;
+    SPI_FIFO = value;
+}
+
+static void spi_flush(void) {
+    SPI_CTRL2 |= SPI_CTRL2_TX_ENABLE;
+    while (SPI_STATUS & SPI_STATUS_TX_LEVEL);
+    while (SPI_STATUS & SPI_STATUS_BUSY);
+    SPI_CTRL2 &= ~SPI_CTRL2_TX_ENABLE;
+}
+
+static void lcd_command(uint8_t cmd, const uint8_t *params, int count) {
+    spi_write(false, cmd);
+    for (int i = 0; i < count; i++) {
+        spi_write(true, params[i]);
+    }
+    spi_flush();
+}
+
+static void lcd_window(int columns, int rows) {
+    uint8_t caset[4] = { 0, 0, (uint8_t)((columns - 1) >> 8), (uint8_t)(columns - 1) };
+    uint8_t raset[4] = { 0, 0, (uint8_t)((rows - 1) >> 8), (uint8_t)(rows - 1) };
+    lcd_command(LCD_CMD_CASET, caset, 4);
+    lcd_command(LCD_CMD_RASET, raset, 4);
+}
+
+void lcd_set_column_major(bool enable) {
+    uint8_t madctl = enable ? LCD_MADCTL_COLUMN_MAJOR : LCD_MADCTL_ROW_MAJOR;
+
+    lcd_command(LCD_CMD_MADCTL, &madctl, 1);
+    if (enable) {
+        lcd_window(LCD_HEIGHT, LCD_WIDTH);
+    } else {
+        lcd_window(LCD_WIDTH, LCD_HEIGHT);
+    }
+}
@@ -0,0 +1,8 @@
+#ifndef LCD_H
+#define LCD_H
+
+#include <stdbool.h>
+
+void lcd_set_column_major(bool enable);
+
+#endif
@@ -7,7 +7,37 @@
 #define CELL_DOOR LEVEL_CELL_DOOR
 #define CELL_EXIT LEVEL_CELL_EXIT
 
-static uint8_t map[MAP_WIDTH][MAP_HEIGHT];
+#define ROOM_MIN 5
+#define ROOM_MAX 10
+#define ROOM_AREA 144
+#define PVS_RANGE 24
+
+typedef struct {
+    int x1, y1, x2, y2;
+} hallway_t;
+
+typedef struct {
+    int x, y, w, h;
+} zone_rect_t;
+
+#if LEVEL_PACKED
+uint8_t level_pack[LEVEL_MAP_ROWS * LEVEL_PACK_STRIDE];
+#endif
+uint8_t level_solid[LEVEL_MAP_ROWS * LEVEL_SOLID_STRIDE];
+uint8_t level_window[LEVEL_ROWS * LEVEL_STRIDE];
+uint8_t level_dist[LEVEL_ROWS * LEVEL_STRIDE];
+int level_window_base = 0;
+uint8_t level_pvs[LEVEL_PVS_BYTES];
+uint16_t level_pvs_start[LEVEL_MAX_ZONES + 1];
+int level_pvs_listed = 0;
+
+static uint8_t pvs_seen[LEVEL_MAP_ROWS * LEVEL_SOLID_STRIDE];
+static hallway_t hallways[MAX_ROOMS];
+static int num_hallways = 0;
+
+static int window_x = -1;
+static int window_y = -1;
+
 static int exit_x = 0;
 static int exit_y = 0;
 static room_t rooms[MAX_ROOMS];
@@ -20,11 +50,33 @@ static uint32_t rng_next(void) {
     return (rng_state >> 16) & 0x7FFF;
 }
 
+#if LEVEL_PACKED
+static inline int cell_get(int x, int y) {
+    int i = x + 1;
+    return (level_pack[(y + 1) * LEVEL_PACK_STRIDE + (i >> 2)] >> ((i & 3) << 1)) & 3;
+}
+
+static inline void cell_set(int x, int y, int cell) {
+    int i = x + 1;
+    uint8_t *p = &level_pack[(y + 1) * LEVEL_PACK_STRIDE + (i >> 2)];
+    int shift = (i & 3) << 1;
+    *p = (uint8_t)((*p & ~(3 << shift)) | (cell << shift));
+}
+#else
+static inline int cell_get(int x, int y) {
+    return level_window[(y + 1) * LEVEL_STRIDE + x + 1];
+}
+
+static inline void cell_set(int x, int y, int cell) {
+    level_window[(y + 1) * LEVEL_STRIDE + x + 1] = (uint8_t)cell;
+}
+#endif
+
 static void generate_room(int x, int y, int w, int h) {
     for (int i = x + 1; i < x + w - 1; i++) {
         for (int j = y + 1; j < y + h - 1; j++) {
             if (i >= 0 && i < MAP_WIDTH && j >= 0 && j < MAP_HEIGHT) {
-                map[i][j] = CELL_EMPTY;
+                cell_set(i, j, CELL_EMPTY);
             }
         }
     }
@@ -35,7 +87,7 @@ static void generate_hallway(int x1, int y1, int x2, int y2) {
     int end_x = (x1 < x2) ? x2 : x1;
     for (int x = start_x; x <= end_x; x++) {
         if (x >= 0 && x < MAP_WIDTH && y1 >= 0 && y1 < MAP_HEIGHT) {
-            map[x][y1] = CELL_EMPTY;
+            cell_set(x, y1, CELL_EMPTY);
         }
     }
 
@@ -43,74 +95,522 @@ static void generate_hallway(int x1, int y1, int x2, int y2) {
     int end_y = (y1 < y2) ? y2 : y1;
     for (int y = start_y; y <= end_y; y++) {
         if (x2 >= 0 && x2 < MAP_WIDTH && y >= 0 && y < MAP_HEIGHT) {
-            map[x2][y] = CELL_EMPTY;
+            cell_set(x2, y, CELL_EMPTY);
         }
     }
 
     if (x1 >= 0 && x1 < MAP_WIDTH && y2 >= 0 && y2 < MAP_HEIGHT) {
-        map[x1][y2] = CELL_EMPTY;
+        cell_set(x1, y2, CELL_EMPTY);
     }
     if (x2 >= 0 && x2 < MAP_WIDTH && y1 >= 0 && y1 < MAP_HEIGHT) {
-        map[x2][y1] = CELL_EMPTY;
+        cell_set(x2, y1, CELL_EMPTY);
     }
 }
 
-void level_init(uint32_t seed) {
-    rng_state = seed;
-    if (rng_state == 0) rng_state = 1;
+static void place_room(int x, int y, int w, int h) {
+    room_t *room = &rooms[num_rooms++];
+    int max_w = (w < ROOM_MAX) ? w : ROOM_MAX;
+    int max_h = (h < ROOM_MAX) ? h : ROOM_MAX;
+    room->w = ROOM_MIN + (rng_next() % (max_w - ROOM_MIN + 1));
+    room->h = ROOM_MIN + (rng_next() % (max_h - ROOM_MIN + 1));
+    room->x = x + (rng_next() % (w - room->w + 1));
+    room->y = y + (rng_next() % (h - room->h + 1));
+    room->center_x = room->x + room->w / 2;
+    room->center_y = room->y + room->h / 2;
+    generate_room(room->x, room->y, room->w, room->h);
+}
+
+static void connect_rooms(const room_t *a, const room_t *b) {
+    if (!(rng_next() & 1)) {
+        const room_t *t = a;
+        a = b;
+        b = t;
+    }
+
+    hallway_t *h = &hallways[num_hallways++];
+    h->x1 = a->center_x;
+    h->y1 = a->center_y;
+    h->x2 = b->center_x;
+    h->y2 = b->center_y;
+    generate_hallway(h->x1, h->y1, h->x2, h->y2);
+}
+
+/*
+ * Places k rooms in the area, which must hold a (w / ROOM_MIN) x
+ * (h / ROOM_MIN) grid of at least k slots. The area is cut into two parts
+ * whose slot grids still fit their share of the rooms, so every split
+ * succeeds and each room is placed exactly once. Rooms are appended in tree
+ * order, so the last room of the first part and the first of the second lie
+ * in areas on either side of the cut; a hallway between them joins the two
+ * halves, which keeps the whole level connected. Recursion depth is at most
+ * cols + rows.
+ */
+static void split_area(int x, int y, int w, int h, int k) {
+    if (k == 1) {
+        place_room(x, y, w, h);
+        return;
+    }
+
+    int cols = w / ROOM_MIN;
+    int rows = h / ROOM_MIN;
+    bool cut_x = cols > 1 && (rows == 1 || w > h || (w == h && (rng_next() & 1)));
+    int slots = cut_x ? cols : rows;
+    int across = cut_x ? rows : cols;
+    int length = cut_x ? w : h;
+
+    int first_slots = 1 + (rng_next() % (slots - 1));
+    int k1 = k * first_slots / slots;
+    if (k1 < k - (slots - first_slots) * across) k1 = k - (slots - first_slots) * across;
+    if (k1 > first_slots * across) k1 = first_slots * across;
+    if (k1 < 1) k1 = 1;
+    if (k1 > k - 1) k1 = k - 1;
+
+    int cut = first_slots * ROOM_MIN + (rng_next() % (length - slots * ROOM_MIN + 1));
+
+    if (cut_x) {
+        split_area(x, y, cut, h, k1);
+        int last = num_rooms - 1;
+        split_area(x + cut, y, w - cut, h, k - k1);
+        connect_rooms(&rooms[last], &rooms[last + 1]);
+    } else {
+        split_area(x, y, w, cut, k1);
+        int last = num_rooms - 1;
+        split_area(x, y + cut, w, h - cut, k - k1);
+        connect_rooms(&rooms[last], &rooms[last + 1]);
+    }
+}
+
+static void build_solid_map(void) {
+    memset(level_solid, 0, sizeof(level_solid));
+    for (int y = -1; y <= MAP_HEIGHT; y++) {
+        for (int x = -1; x <= MAP_WIDTH; x++) {
+            if (cell_get(x, y) == CELL_WALL) {
+                level_solid[(y + 1) * LEVEL_SOLID_STRIDE + ((x + 1) >> 3)] |= (uint8_t)(1 << ((x + 1) & 7));
+            }
+        }
+    }
+}
+
+static inline uint8_t dist_min(uint8_t a, uint8_t b) {
+    return (a < b) ? a : b;
+}
+
+/*
+ * Recomputes level_dist over a window rectangle, clipped to the interior, with
+ * the cells around it as fixed boundary values. Two passes of an 8-neighbour
+ * chamfer with unit weights give the Chebyshev distance. Cells beyond the
+ * window edge are unknown, so edge cells are never larger than the truth.
+ */
+static void dist_rebuild(int x0, int y0, int x1, int y1) {
+    if (x0 < 1) x0 = 1;
+    if (y0 < 1) y0 = 1;
+    if (x1 > LEVEL_STRIDE - 1) x1 = LEVEL_STRIDE - 1;
+    if (y1 > LEVEL_ROWS - 1) y1 = LEVEL_ROWS - 1;
+
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            int i = y * LEVEL_STRIDE + x;
+            level_dist[i] = (level_window[i] == CELL_EMPTY) ? LEVEL_DIST_MAX : 0;
+        }
+    }
+
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            uint8_t *d = &level_dist[y * LEVEL_STRIDE + x];
+            if (*d == 0) continue;
+            int n = dist_min(dist_min(d[-1], d[-LEVEL_STRIDE - 1]),
+                             dist_min(d[-LEVEL_STRIDE], d[-LEVEL_STRIDE + 1]));
+            if (n + 1 < *d) *d = (uint8_t)(n + 1);
+        }
+    }
+
+    for (int y = y1 - 1; y >= y0; y--) {
+        for (int x = x1 - 1; x >= x0; x--) {
+            uint8_t *d = &level_dist[y * LEVEL_STRIDE + x];
+            if (*d == 0) continue;
+            int n = dist_min(dist_min(d[1], d[LEVEL_STRIDE + 1]),
+                             dist_min(d[LEVEL_STRIDE], d[LEVEL_STRIDE - 1]));
+            if (n + 1 < *d) *d = (uint8_t)(n + 1);
+        }
+    }
+}
 
-    memset(map, CELL_WALL, sizeof(map));
+#if LEVEL_PACKED
+/* Unpacks a window rectangle from level_pack; its distances are left at 0. */
+static void window_fill(int x0, int y0, int x1, int y1) {
+    for (int y = y0; y < y1; y++) {
+        uint8_t *cell = &level_window[y * LEVEL_STRIDE];
+        uint8_t *dist = &level_dist[y * LEVEL_STRIDE];
+        for (int x = x0; x < x1; x++) {
+            cell[x] = (uint8_t)cell_get(window_x + x, window_y + y);
+            dist[x] = 0;
+        }
+    }
+}
 
-    num_rooms = 4 + (rng_next() % 3);
+static void window_refill(void) {
+    window_fill(0, 0, LEVEL_STRIDE, LEVEL_ROWS);
+    dist_rebuild(0, 0, LEVEL_STRIDE, LEVEL_ROWS);
+}
 
-    for (int i = 0; i < num_rooms; i++) {
-        int attempts = 0;
-        bool placed = false;
+/*
+ * Slides the window by (dx, dy) cells: the kept cells move with one memmove,
+ * the newly exposed strips are unpacked, and distances are rebuilt for those
+ * strips plus the LEVEL_DIST_MAX cells next to them, which the old edge held
+ * down.
+ */
+static void window_shift(int dx, int dy) {
+    int k = dy * LEVEL_STRIDE + dx;
+    int n = LEVEL_ROWS * LEVEL_STRIDE;
+    if (k > 0) {
+        memmove(level_window, level_window + k, (size_t)(n - k));
+        memmove(level_dist, level_dist + k, (size_t)(n - k));
+    } else {
+        memmove(level_window - k, level_window, (size_t)(n + k));
+        memmove(level_dist - k, level_dist, (size_t)(n + k));
+    }
 
-        while (!placed && attempts < 100) {
-            rooms[i].w = 3 + (rng_next() % 2);
-            rooms[i].h = 3 + (rng_next() % 2);
-            rooms[i].x = 2 + (rng_next() % (MAP_WIDTH / 2));
-            rooms[i].y = 2 + (rng_next() % (MAP_HEIGHT / 2));
+    if (dx > 0) {
+        window_fill(LEVEL_STRIDE - dx, 0, LEVEL_STRIDE, LEVEL_ROWS);
+    } else if (dx < 0) {
+        window_fill(0, 0, -dx, LEVEL_ROWS);
+    }
+    if (dy > 0) {
+        window_fill(0, LEVEL_ROWS - dy, LEVEL_STRIDE, LEVEL_ROWS);
+    } else if (dy < 0) {
+        window_fill(0, 0, LEVEL_STRIDE, -dy);
+    }
+
+    int band = LEVEL_DIST_MAX + 1;
+    if (dx > 0) {
+        dist_rebuild(LEVEL_STRIDE - dx - band, 0, LEVEL_STRIDE, LEVEL_ROWS);
+    } else if (dx < 0) {
+        dist_rebuild(0, 0, -dx + band, LEVEL_ROWS);
+    }
+    if (dy > 0) {
+        dist_rebuild(0, LEVEL_ROWS - dy - band, LEVEL_STRIDE, LEVEL_ROWS);
+    } else if (dy < 0) {
+        dist_rebuild(0, 0, LEVEL_STRIDE, -dy + band);
+    }
+}
+#else
+/* The window is the map itself, so only the distances need building. */
+static void window_refill(void) {
+    dist_rebuild(0, 0, LEVEL_STRIDE, LEVEL_ROWS);
+}
+#endif
+
+/* Chunk-aligned origin that keeps LEVEL_WINDOW_CHUNKS / 2 chunks around p, clamped to the map. */
+static int window_origin(int p, int cols, int size) {
+    if (cols <= size) {
+        return -1;
+    }
+
+    int origin = ((p >> LEVEL_CHUNK_SHIFT) - LEVEL_WINDOW_CHUNKS / 2) * LEVEL_CHUNK;
+    if (origin < -1) return -1;
+    if (origin > cols - 1 - size) return cols - 1 - size;
+    return origin;
+}
+
+static void window_place(int x, int y) {
+    window_x = x;
+    window_y = y;
+    level_window_base = window_y * LEVEL_STRIDE + window_x;
+}
+
+void level_focus(int x, int y) {
+#if LEVEL_PACKED
+    int nx = window_origin(x, LEVEL_MAP_COLS, LEVEL_STRIDE);
+    int ny = window_origin(y, LEVEL_MAP_ROWS, LEVEL_ROWS);
+    int dx = nx - window_x;
+    int dy = ny - window_y;
+    if (dx == 0 && dy == 0) {
+        return;
+    }
+
+    window_place(nx, ny);
+    if (abs(dx) >= LEVEL_STRIDE || abs(dy) >= LEVEL_ROWS) {
+        window_refill();
+    } else {
+        window_shift(dx, dy);
+    }
+#else
+    (void)x;
+    (void)y;
+#endif
+}
 
-            bool overlap = false;
-            for (int j = 0; j < i; j++) {
-                if (!(rooms[i].x + rooms[i].w + 1 < rooms[j].x ||
-                      rooms[j].x + rooms[j].w + 1 < rooms[i].x ||
-                      rooms[i].y + rooms[i].h + 1 < rooms[j].y ||
-                      rooms[j].y + rooms[j].h + 1 < rooms[i].y)) {
-                    overlap = true;
-                    break;
+/* A room zone is its interior; a hallway zone is its horizontal and vertical legs. */
+static int zone_rects(int zone, zone_rect_t rects[2]) {
+    if (zone < num_rooms) {
+        const room_t *r = &rooms[zone];
+        rects[0] = (zone_rect_t){ r->x + 1, r->y + 1, r->w - 2, r->h - 2 };
+        return 1;
+    }
+
+    const hallway_t *h = &hallways[zone - num_rooms];
+    int x0 = (h->x1 < h->x2) ? h->x1 : h->x2;
+    int y0 = (h->y1 < h->y2) ? h->y1 : h->y2;
+    rects[0] = (zone_rect_t){ x0, h->y1, abs(h->x2 - h->x1) + 1, 1 };
+    rects[1] = (zone_rect_t){ h->x2, y0, 1, abs(h->y2 - h->y1) + 1 };
+    return 2;
+}
+
+int level_get_zone_count(void) {
+    return num_rooms + num_hallways;
+}
+
+int level_zone_at(int x, int y) {
+    int count = num_rooms + num_hallways;
+    for (int z = 0; z < count; z++) {
+        zone_rect_t rects[2];
+        int n = zone_rects(z, rects);
+        for (int i = 0; i < n; i++) {
+            if (x >= rects[i].x && x < rects[i].x + rects[i].w &&
+                y >= rects[i].y && y < rects[i].y + rects[i].h) {
+                return z;
+            }
+        }
+    }
+    return LEVEL_ZONE_NONE;
+}
+
+static inline bool seen_get(int x, int y) {
+    int i = x + 1;
+    return (pvs_seen[(y + 1) * LEVEL_SOLID_STRIDE + (i >> 3)] >> (i & 7)) & 1;
+}
+
+static inline void seen_set(int x, int y) {
+    int i = x + 1;
+    pvs_seen[(y + 1) * LEVEL_SOLID_STRIDE + (i >> 3)] |= (uint8_t)(1 << (i & 7));
+}
+
+static const int8_t octants[8][4] = {
+    { 1, 0, 0, 1 }, { 0, 1, 1, 0 }, { 0, -1, 1, 0 }, { -1, 0, 0, 1 },
+    { -1, 0, 0, -1 }, { 0, -1, -1, 0 }, { 0, 1, -1, 0 }, { 1, 0, 0, -1 }
+};
+
+/*
+ * Recursive shadowcasting over one octant from the centre of (cx, cy): marks
+ * every open cell within PVS_RANGE whose square is lit between the start and
+ * end slopes in pvs_seen. A slope is kept as num / den with den > 0 and
+ * compared by cross-multiplying. Column c of row j spans slopes
+ * (2c - 1) / (2j + 1) to (2c + 1) / (2j - 1), so no term exceeds
+ * 2 * PVS_RANGE + 1 and every product fits in 24 bits.
+ */
+static void shadow_cast(int cx, int cy, int row, int start_num, int start_den,
+                        int end_num, int end_den, const int8_t *m) {
+    if (start_num * end_den < end_num * start_den) {
+        return;
+    }
+
+    int next_num = start_num;
+    int next_den = start_den;
+    for (int j = row; j <= PVS_RANGE; j++) {
+        bool blocked = false;
+        for (int c = j; c >= 0; c--) {
+            int left_num = 2 * c + 1;
+            int left_den = 2 * j - 1;
+            int right_num = 2 * c - 1;
+            int right_den = 2 * j + 1;
+            if (start_num * right_den < right_num * start_den) continue;
+            if (end_num * left_den > left_num * end_den) break;
+
+            int dx = -c;
+            int dy = -j;
+            int x = cx + dx * m[0] + dy * m[1];
+            int y = cy + dx * m[2] + dy * m[3];
+            bool solid = x < -1 || x > MAP_WIDTH || y < -1 || y > MAP_HEIGHT || LEVEL_SOLID(x, y);
+            if (!solid && c * c + j * j <= PVS_RANGE * PVS_RANGE) {
+                seen_set(x, y);
+            }
+
+            if (blocked) {
+                if (solid) {
+                    next_num = right_num;
+                    next_den = right_den;
+                } else {
+                    blocked = false;
+                    start_num = next_num;
+                    start_den = next_den;
                 }
+            } else if (solid && j < PVS_RANGE) {
+                blocked = true;
+                shadow_cast(cx, cy, j + 1, start_num, start_den, left_num, left_den, m);
+                next_num = right_num;
+                next_den = right_den;
             }
+        }
+        if (blocked) {
+            break;
+        }
+    }
+}
+
+/* Looks for zone to in zone from's list; ids ascend, so the scan stops at the first one past it. */
+static bool pvs_lists(int from, int to) {
+    const uint8_t *p = &level_pvs[level_pvs_start[from]];
+    const uint8_t *end = &level_pvs[level_pvs_start[from + 1]];
+    int zone = -1;
+    while (p < end) {
+        uint8_t delta = *p++;
+        if (delta == 0) {
+            zone += 255;
+            continue;
+        }
+        zone += delta;
+        if (zone >= to) {
+            return zone == to;
+        }
+    }
+    return false;
+}
+
+static bool pvs_append(int *used, int delta) {
+    int bytes = 1 + (delta - 1) / 255;
+    if (*used + bytes > LEVEL_PVS_BYTES) {
+        return false;
+    }
+    for (; delta > 255; delta -= 255) {
+        level_pvs[(*used)++] = 0;
+    }
+    level_pvs[(*used)++] = (uint8_t)delta;
+    return true;
+}
 
-            if (!overlap) {
-                generate_room(rooms[i].x, rooms[i].y, rooms[i].w, rooms[i].h);
-                rooms[i].center_x = rooms[i].x + rooms[i].w / 2;
-                rooms[i].center_y = rooms[i].y + rooms[i].h / 2;
-                placed = true;
+/*
+ * For each zone, shadowcasts from the centre of every cell on the edge of its
+ * rectangles, then lists the zones with a seen cell in their area or the ring
+ * around it. Zone rectangles are open, so a sight line from an inner cell
+ * leaves through an edge cell that is nearer its target. The ring makes up
+ * for sampling cell centres only. The relation is made symmetric by
+ * level_zone_sees() checking both lists. Once a list overflows the pool, it
+ * and every later zone are left unlisted.
+ */
+void level_build_pvs(void) {
+    int count = num_rooms + num_hallways;
+    int used = 0;
+    level_pvs_listed = count;
+
+    for (int a = 0; a < count; a++) {
+        level_pvs_start[a] = (uint16_t)used;
+        if (a >= level_pvs_listed) {
+            continue;
+        }
+
+        zone_rect_t rects[2];
+        int n = zone_rects(a, rects);
+
+        memset(pvs_seen, 0, sizeof(pvs_seen));
+        int lo_x = MAP_WIDTH;
+        int lo_y = MAP_HEIGHT;
+        int hi_x = -1;
+        int hi_y = -1;
+        for (int i = 0; i < n; i++) {
+            int x0 = rects[i].x;
+            int y0 = rects[i].y;
+            int x1 = x0 + rects[i].w - 1;
+            int y1 = y0 + rects[i].h - 1;
+            if (x0 < lo_x) lo_x = x0;
+            if (y0 < lo_y) lo_y = y0;
+            if (x1 > hi_x) hi_x = x1;
+            if (y1 > hi_y) hi_y = y1;
+            for (int y = y0; y <= y1; y++) {
+                bool edge_row = y == y0 || y == y1;
+                for (int x = x0; x <= x1; x++) {
+                    seen_set(x, y);
+                    if (!edge_row && x != x0 && x != x1) continue;
+                    for (int o = 0; o < 8; o++) {
+                        shadow_cast(x, y, 1, 1, 1, 0, 1, octants[o]);
+                    }
+                }
             }
-            attempts++;
+        }
+
+        /* Lit cells lie within PVS_RANGE of zone a, so only that box is searched. */
+        lo_x -= PVS_RANGE;
+        lo_y -= PVS_RANGE;
+        hi_x += PVS_RANGE;
+        hi_y += PVS_RANGE;
+
+        int prev = -1;
+        for (int b = 0; b < count; b++) {
+            if (b == a || (b < a && pvs_lists(b, a))) continue;
+
+            bool seen = false;
+            n = zone_rects(b, rects);
+            for (int i = 0; i < n && !seen; i++) {
+                int x0 = (rects[i].x - 1 > lo_x) ? rects[i].x - 1 : lo_x;
+                int y0 = (rects[i].y - 1 > lo_y) ? rects[i].y - 1 : lo_y;
+                int x1 = (rects[i].x + rects[i].w < hi_x) ? rects[i].x + rects[i].w : hi_x;
+                int y1 = (rects[i].y + rects[i].h < hi_y) ? rects[i].y + rects[i].h : hi_y;
+                for (int y = y0; y <= y1 && !seen; y++) {
+                    for (int x = x0; x <= x1; x++) {
+                        if (seen_get(x, y)) {
+                            seen = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            if (!seen) continue;
+
+            if (!pvs_append(&used, b - prev)) {
+                used = level_pvs_start[a];
+                level_pvs_listed = a;
+                break;
+            }
+            prev = b;
         }
     }
+    level_pvs_start[count] = (uint16_t)used;
+}
 
-    for (int i = 1; i < num_rooms; i++) {
-        int prev = i - 1;
-        generate_hallway(rooms[prev].center_x, rooms[prev].center_y,
-                        rooms[i].center_x, rooms[i].center_y);
+/* Cells outside every zone (LEVEL_ZONE_NONE), and unlisted zones, see and are seen by everything. */
+bool level_zone_sees(int from, int to) {
+    if (from < 0 || to < 0 || from == to) {
+        return true;
+    }
+    if (from >= level_pvs_listed || to >= level_pvs_listed) {
+        return true;
     }
+    return pvs_lists(from, to) || pvs_lists(to, from);
+}
+
+void level_init(uint32_t seed) {
+    rng_state = seed;
+    if (rng_state == 0) rng_state = 1;
+
+#if LEVEL_PACKED
+    /* 0x55 is CELL_WALL in all four 2-bit slots. */
+    memset(level_pack, 0x55, sizeof(level_pack));
+#else
+    memset(level_window, CELL_WALL, sizeof(level_window));
+#endif
+
+    int cols = MAP_WIDTH / ROOM_MIN;
+    int rows = MAP_HEIGHT / ROOM_MIN;
+    int base = (MAP_WIDTH * MAP_HEIGHT) / ROOM_AREA;
+    if (base < 2) base = 2;
+    int count = base + (rng_next() % (base / 2 + 1));
+    if (count > MAX_ROOMS) count = MAX_ROOMS;
+    if (count > cols * rows) count = cols * rows;
+
+    num_rooms = 0;
+    num_hallways = 0;
+    split_area(0, 0, MAP_WIDTH, MAP_HEIGHT, count);
 
     exit_x = rooms[num_rooms - 1].center_x;
     exit_y = rooms[num_rooms - 1].center_y;
-    map[exit_x][exit_y] = CELL_EXIT;
+    cell_set(exit_x, exit_y, CELL_EXIT);
 
     for (int dx = -1; dx <= 1; dx++) {
         for (int dy = -1; dy <= 1; dy++) {
             int ex = exit_x + dx;
             int ey = exit_y + dy;
             if (ex >= 0 && ex < MAP_WIDTH && ey >= 0 && ey < MAP_HEIGHT) {
-                if (map[ex][ey] != CELL_WALL) {
-                    map[ex][ey] = CELL_EXIT;
+                if (cell_get(ex, ey) != CELL_WALL) {
+                    cell_set(ex, ey, CELL_EXIT);
                 }
             }
         }
@@ -119,22 +619,24 @@ void level_init(uint32_t seed) {
     if (num_rooms > 0) {
         int spawn_x = rooms[0].center_x;
         int spawn_y = rooms[0].center_y;
-        map[spawn_x][spawn_y] = CELL_EMPTY;
-        map[spawn_x-1][spawn_y] = CELL_EMPTY;
-        map[spawn_x+1][spawn_y] = CELL_EMPTY;
-        map[spawn_x][spawn_y-1] = CELL_EMPTY;
-        map[spawn_x][spawn_y+1] = CELL_EMPTY;
+        cell_set(spawn_x, spawn_y, CELL_EMPTY);
+        cell_set(spawn_x-1, spawn_y, CELL_EMPTY);
+        cell_set(spawn_x+1, spawn_y, CELL_EMPTY);
+        cell_set(spawn_x, spawn_y-1, CELL_EMPTY);
+        cell_set(spawn_x, spawn_y+1, CELL_EMPTY);
     }
-}
 
-void level_cleanup(void) {
+    build_solid_map();
+    level_build_pvs();
+
+    int focus_x = (num_rooms > 0) ? rooms[0].center_x : 0;
+    int focus_y = (num_rooms > 0) ? rooms[0].center_y : 0;
+    window_place(window_origin(focus_x, LEVEL_MAP_COLS, LEVEL_STRIDE),
+                 window_origin(focus_y, LEVEL_MAP_ROWS, LEVEL_ROWS));
+    window_refill();
 }
 
-bool level_is_wall(int x, int y) {
-    if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT) {
-        return true;
-    }
-    return map[x][y] == CELL_WALL;
+void level_cleanup(void) {
 }
 
 bool level_is_at_exit(float x, float y) {
@@ -148,13 +650,6 @@ bool level_is_at_exit(float x, float y) {
     return false;
 }
 
-int level_get_cell(int x, int y) {
-    if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT) {
-        return CELL_WALL;
-    }
-    return map[x][y];
-}
-
 int level_get_room_count(void) {
     return num_rooms;
 }
@@ -9,9 +9,79 @@
 #define LEVEL_CELL_DOOR 2
 #define LEVEL_CELL_EXIT 3
 
+#ifndef MAP_WIDTH
 #define MAP_WIDTH 24
+#endif
+#ifndef MAP_HEIGHT
 #define MAP_HEIGHT 24
-#define MAX_ROOMS 12
+#endif
+#ifndef MAX_ROOMS
+#define MAX_ROOMS (MAP_WIDTH * MAP_HEIGHT / 96)
+#endif
+
+#define LEVEL_MAP_COLS (MAP_WIDTH + 2)
+#define LEVEL_MAP_ROWS (MAP_HEIGHT + 2)
+#define LEVEL_PACK_STRIDE ((LEVEL_MAP_COLS + 3) / 4)
+#define LEVEL_SOLID_STRIDE ((LEVEL_MAP_COLS + 7) / 8)
+
+#define LEVEL_CHUNK_SHIFT 3
+#define LEVEL_CHUNK (1 << LEVEL_CHUNK_SHIFT)
+#ifndef LEVEL_WINDOW_CHUNKS
+#define LEVEL_WINDOW_CHUNKS 7
+#endif
+#define LEVEL_WINDOW_MAX (LEVEL_CHUNK * LEVEL_WINDOW_CHUNKS)
+#define LEVEL_STRIDE ((LEVEL_MAP_COLS < LEVEL_WINDOW_MAX) ? LEVEL_MAP_COLS : LEVEL_WINDOW_MAX)
+#define LEVEL_ROWS ((LEVEL_MAP_ROWS < LEVEL_WINDOW_MAX) ? LEVEL_MAP_ROWS : LEVEL_WINDOW_MAX)
+#define LEVEL_PACKED (LEVEL_MAP_COLS > LEVEL_WINDOW_MAX || LEVEL_MAP_ROWS > LEVEL_WINDOW_MAX)
+#define LEVEL_DIST_MAX LEVEL_CHUNK
+
+#define LEVEL_MAX_ZONES (2 * MAX_ROOMS - 1)
+#ifndef LEVEL_PVS_BYTES
+#define LEVEL_PVS_BYTES (LEVEL_MAX_ZONES * 8)
+#endif
+#define LEVEL_ZONE_NONE (-1)
+
+/*
+ * The whole map, with a one-cell solid border, lives in level_pack at two
+ * bits per cell; level_solid holds one bit per cell, set for cells that block
+ * movement, so any x in [-1, MAP_WIDTH] and y in [-1, MAP_HEIGHT] is a valid
+ * unchecked LEVEL_SOLID() lookup.
+ *
+ * LEVEL_CELL() reads level_window instead: an unpacked, row-major copy of the
+ * cells around the point last passed to level_focus(). The window is at
+ * least LEVEL_WINDOW_CHUNKS / 2 chunks wide on each side of the focus chunk.
+ * When the whole map fits in the window (LEVEL_PACKED is 0) there is no
+ * level_pack: level_window holds the map itself and never moves. level_dist
+ * shares its indexing and holds the Chebyshev distance to the nearest
+ * non-empty cell, capped at LEVEL_DIST_MAX (0 for non-empty cells).
+ */
+#define LEVEL_INDEX(x, y) ((y) * LEVEL_STRIDE + (x) - level_window_base)
+#define LEVEL_CELL(x, y) (level_window[LEVEL_INDEX(x, y)])
+#define LEVEL_DIST(x, y) (level_dist[LEVEL_INDEX(x, y)])
+#define LEVEL_SOLID(x, y) \
+    ((level_solid[((y) + 1) * LEVEL_SOLID_STRIDE + (((x) + 1) >> 3)] >> (((x) + 1) & 7)) & 1)
+
+#if LEVEL_PACKED
+extern uint8_t level_pack[LEVEL_MAP_ROWS * LEVEL_PACK_STRIDE];
+#endif
+extern uint8_t level_solid[LEVEL_MAP_ROWS * LEVEL_SOLID_STRIDE];
+extern uint8_t level_window[LEVEL_ROWS * LEVEL_STRIDE];
+extern uint8_t level_dist[LEVEL_ROWS * LEVEL_STRIDE];
+extern int level_window_base;
+
+/*
+ * Zones are the rooms (0 .. room count - 1) followed by one per hallway.
+ * level_pvs[level_pvs_start[a] .. level_pvs_start[a + 1]) lists, in
+ * ascending order, the zones some cell of which may be seen from some cell
+ * of zone a. Each id is stored as a byte delta from the previous one
+ * (starting at -1), and a 0 byte adds 255 without ending an entry. A zone
+ * below a whose own list names a is left out, so most pairs are stored once.
+ * Zones from level_pvs_listed on did not fit in LEVEL_PVS_BYTES and are
+ * treated as seeing everything.
+ */
+extern uint8_t level_pvs[LEVEL_PVS_BYTES];
+extern uint16_t level_pvs_start[LEVEL_MAX_ZONES + 1];
+extern int level_pvs_listed;
 
 typedef struct {
     int x, y, w, h;
@@ -20,11 +90,23 @@ typedef struct {
 
 void level_init(uint32_t seed);
 void level_cleanup(void);
-bool level_is_wall(int x, int y);
 bool level_is_at_exit(float x, float y);
-int level_get_cell(int x, int y);
 int level_get_room_count(void);
 room_t* level_get_rooms(void);
 uint32_t level_get_rng(void);
+void level_focus(int x, int y);
+void level_build_pvs(void);
+int level_get_zone_count(void);
+int level_zone_at(int x, int y);
+bool level_zone_sees(int from, int to);
+
+static inline bool level_is_wall(int x, int y) {
+    return LEVEL_SOLID(x, y);
+}
+
+/* Only valid within the window around the last level_focus() point. */
+static inline int level_get_cell(int x, int y) {
+    return LEVEL_CELL(x, y);
+}
 
 #endif
@@ -3,42 +3,128 @@
 #include <graphx.h>
 #include <keypadc.h>
 #include <fileioc.h>
+#include "fixed.h"
 #include "game.h"
 #include "raycast.h"
 #include "player.h"
 #include "level.h"
 #include "enemy.h"
 #include "ui.h"
+#include "blit.h"
+#include "clock.h"
+#include "scaler.h"
+#include "input.h"
+#include "profile.h"
+#include "bench.h"
+#include "replay.h"
+#include <time.h>
 
-#define FRAME_SKIP 2
-#define RENDER_SKIP 1
+#define TICK_HZ 20
+#define TICK_TICKS (CLOCK_HZ / TICK_HZ)
+#define MAX_CATCHUP_TICKS 4
+
+static void show_replay_report(uint32_t frames, uint32_t ticks, uint32_t elapsed, bool truncated) {
+    uint32_t ms = (elapsed / CLOCK_HZ) * 1000 + (elapsed % CLOCK_HZ) * 1000 / CLOCK_HZ;
+
+    gfx_SetDrawScreen();
+    gfx_FillScreen(255);
+    gfx_SetTextFGColor(0);
+    gfx_PrintStringXY("Replay finished", 8, 8);
+    gfx_PrintStringXY("Frames: ", 8, 24);
+    gfx_PrintUInt(frames, 1);
+    gfx_PrintStringXY("Ticks: ", 8, 36);
+    gfx_PrintUInt(ticks, 1);
+    gfx_PrintStringXY("Time (ms): ", 8, 48);
+    gfx_PrintUInt(ms, 1);
+    gfx_PrintStringXY("FPS x10: ", 8, 60);
+    gfx_PrintUInt(ms ? frames * 10000 / ms : 0, 1);
+    if (truncated) {
+        gfx_PrintStringXY("Recording was cut short", 8, 76);
+    }
+
+    do {
+        kb_Scan();
+    } while (kb_AnyKey());
+    do {
+        kb_Scan();
+    } while (!kb_AnyKey());
+}
 
 int main(void) {
     gfx_Begin();
     gfx_SetDrawBuffer();
+    blit_init();
+
+#if BENCH_MODE
+    bench_run();
+    blit_cleanup();
+    gfx_End();
+    return 0;
+#endif
+
+    uint32_t seed = (uint32_t)time(NULL);
+#if REPLAY_MODE == REPLAY_PLAY
+    replay_play_start(&seed);
+#elif REPLAY_MODE == REPLAY_RECORD
+    replay_record_start(seed);
+#endif
 
-    game_init();
+    game_init(seed);
+    clock_init();
+    scaler_init();
+    PROFILE_INIT();
 
-    static int frame_counter = 0;
+    uint32_t last_time = clock_now();
+    uint32_t last_frame = last_time;
+    uint32_t start_time = last_time;
+    uint32_t frame_count = 0;
+    uint32_t accumulator = 0;
 
     while (game_is_running()) {
-        kb_Scan();
+        input_poll();
+
+        uint32_t now = clock_now();
+        accumulator += now - last_time;
+        last_time = now;
 
-        if ((frame_counter % (FRAME_SKIP + 1)) == 0) {
+        for (int ticks = 0; accumulator >= TICK_TICKS && ticks < MAX_CATCHUP_TICKS; ticks++) {
             game_update();
+            accumulator -= TICK_TICKS;
         }
-
-        if ((frame_counter % (RENDER_SKIP + 1)) == 0) {
-            game_render();
-            gfx_SwapDraw();
+        if (accumulator >= TICK_TICKS) {
+            accumulator %= TICK_TICKS;
         }
 
-        frame_counter++;
+        int alpha = (int)((accumulator << LERP_SHIFT) / TICK_TICKS);
+
+        raycast_set_resolution(scaler_get_ray_step(), scaler_get_view_height());
+        game_render(alpha);
+        PROFILE_BEGIN(PROFILE_SWAP);
+        gfx_SwapDraw();
+        PROFILE_END(PROFILE_SWAP);
+        PROFILE_FRAME_END();
+
+        now = clock_now();
+        input_frame_shown(now);
+        scaler_frame(now - last_frame);
+        last_frame = now;
+        frame_count++;
     }
 
+    bool replayed = replay_get_mode() == REPLAY_PLAY;
+    uint32_t ticks = replay_get_ticks();
+    bool truncated = replay_is_truncated();
+    replay_stop();
+
+    PROFILE_DUMP();
     game_cleanup();
+    blit_cleanup();
+
+    if (replayed) {
+        show_replay_report(frame_count, ticks, last_frame - start_time, truncated);
+    }
+
     gfx_End();
 
     return 0;
 }
-
@@ -1,24 +1,33 @@
 #include "player.h"
 #include "level.h"
 #include "enemy.h"
-#include <keypadc.h>
-#include <math.h>
+#include "angle.h"
+#include "input.h"
 #include <stdbool.h>
 
 #define MOVE_SPEED 0.05
-#define ROT_SPEED 0.05
+#define MOVE_SCALE ((float)MOVE_SPEED / TRIG_ONE)
+#define ROT_SPEED 33
 #define MAX_HP 100
 #define MAX_AMMO 50
 #define START_AMMO 30
 
 static float px = 1.5;
 static float py = 1.5;
-static float angle = 0.0;
+static angle_t angle = 0;
+static float prev_x = 1.5;
+static float prev_y = 1.5;
+static angle_t prev_angle = 0;
+static float view_x = 1.5;
+static float view_y = 1.5;
+static angle_t view_angle = 0;
 static int hp = MAX_HP;
 static int ammo = START_AMMO;
-static bool shoot_pressed = false;
 static bool is_shooting = false;
 static int shoot_timer = 0;
+static int zone = LEVEL_ZONE_NONE;
+static int zone_x = -1;
+static int zone_y = -1;
 
 void player_init(void) {
     int room_count = level_get_room_count();
@@ -31,42 +40,52 @@ void player_init(void) {
         py = 1.5;
     }
 
-    angle = 0.0;
+    angle = 0;
     hp = MAX_HP;
     ammo = START_AMMO;
-    shoot_pressed = false;
 
     if (level_is_wall((int)px, (int)py)) {
         px += 0.5;
         py += 0.5;
     }
+
+    prev_x = px;
+    prev_y = py;
+    prev_angle = angle;
+    zone_x = -1;
+    zone_y = -1;
+    player_interpolate(LERP_ONE);
 }
 
 void player_update(void) {
-    kb_Scan();
+    prev_x = px;
+    prev_y = py;
+    prev_angle = angle;
 
     float new_x = px;
     float new_y = py;
-    float new_angle = angle;
 
-    if (kb_Data[7] & kb_Left) {
-        new_angle += ROT_SPEED;
+    if (input_down(INPUT_LEFT)) {
+        angle += ROT_SPEED;
     }
-    if (kb_Data[7] & kb_Right) {
-        new_angle -= ROT_SPEED;
+    if (input_down(INPUT_RIGHT)) {
+        angle -= ROT_SPEED;
     }
-
-    while (new_angle < 0) new_angle += 2 * M_PI;
-    while (new_angle >= 2 * M_PI) new_angle -= 2 * M_PI;
-    angle = new_angle;
-
-    if (kb_Data[7] & kb_Up) {
-        new_x += cosf(angle) * MOVE_SPEED;
-        new_y += sinf(angle) * MOVE_SPEED;
-    }
-    if (kb_Data[7] & kb_Down) {
-        new_x -= cosf(angle) * MOVE_SPEED;
-        new_y -= sinf(angle) * MOVE_SPEED;
+    angle &= ANGLE_MASK;
+
+    bool forward = input_down(INPUT_UP);
+    bool backward = input_down(INPUT_DOWN);
+    if (forward || backward) {
+        float move_x = angle_cos(angle) * MOVE_SCALE;
+        float move_y = angle_sin(angle) * MOVE_SCALE;
+        if (forward) {
+            new_x += move_x;
+            new_y += move_y;
+        }
+        if (backward) {
+            new_x -= move_x;
+            new_y -= move_y;
+        }
     }
 
     if (!level_is_wall((int)new_x, (int)new_y) &&
@@ -78,16 +97,10 @@ void player_update(void) {
         py = new_y;
     }
 
-    bool shoot_key = kb_Data[1] & kb_2nd;
-    if (shoot_key && !shoot_pressed && ammo > 0) {
-        if (player_shoot()) {
-            enemy_check_shots();
-            is_shooting = true;
-            shoot_timer = 3;
-        }
-        shoot_pressed = true;
-    } else if (!shoot_key) {
-        shoot_pressed = false;
+    if (input_pressed(INPUT_FIRE) && player_shoot()) {
+        enemy_check_shots();
+        is_shooting = true;
+        shoot_timer = 3;
     }
 
     if (shoot_timer > 0) {
@@ -110,10 +123,40 @@ float player_get_y(void) {
     return py;
 }
 
-float player_get_angle(void) {
+angle_t player_get_angle(void) {
     return angle;
 }
 
+void player_set_pose(float x, float y, angle_t a) {
+    px = x;
+    py = y;
+    angle = a & ANGLE_MASK;
+    prev_x = px;
+    prev_y = py;
+    prev_angle = angle;
+    player_interpolate(LERP_ONE);
+}
+
+/* alpha is the fraction of a tick since the last update, 0..LERP_ONE. */
+void player_interpolate(int alpha) {
+    float t = (float)alpha / LERP_ONE;
+    view_x = prev_x + (px - prev_x) * t;
+    view_y = prev_y + (py - prev_y) * t;
+    view_angle = (angle_t)(prev_angle + ((angle_diff(angle, prev_angle) * alpha) >> LERP_SHIFT)) & ANGLE_MASK;
+}
+
+float player_get_view_x(void) {
+    return view_x;
+}
+
+float player_get_view_y(void) {
+    return view_y;
+}
+
+angle_t player_get_view_angle(void) {
+    return view_angle;
+}
+
 int player_get_hp(void) {
     return hp;
 }
@@ -139,3 +182,13 @@ bool player_shoot(void) {
     return true;
 }
 
+int player_get_zone(void) {
+    int x = (int)px;
+    int y = (int)py;
+    if (x != zone_x || y != zone_y) {
+        zone_x = x;
+        zone_y = y;
+        zone = level_zone_at(x, y);
+    }
+    return zone;
+}
@@ -2,17 +2,24 @@
 #define PLAYER_H
 
 #include <stdbool.h>
+#include "angle.h"
 
 void player_init(void);
 void player_update(void);
 float player_get_x(void);
 float player_get_y(void);
-float player_get_angle(void);
+angle_t player_get_angle(void);
+void player_set_pose(float x, float y, angle_t a);
+void player_interpolate(int alpha);
+float player_get_view_x(void);
+float player_get_view_y(void);
+angle_t player_get_view_angle(void);
 int player_get_hp(void);
 int player_get_ammo(void);
 void player_take_damage(int damage);
 void player_add_ammo(int amount);
 bool player_shoot(void);
 bool player_is_shooting(void);
+int player_get_zone(void);
 
 #endif
@@ -0,0 +1,175 @@
+#include "profile.h"
+
+#if PROFILE_ENABLE
+#include "blit.h"
+#include "raycast.h"
+#include <graphx.h>
+#include <fileioc.h>
+#include <sys/timers.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROFILE_TIMER 2
+#define CYCLES_PER_US 48
+
+#define LOG_FRAMES 128
+#define WINDOW_FRAMES 32
+#define APPVAR_NAME "FPSPROF"
+
+#define OVERLAY_X 4
+#define OVERLAY_Y 40
+#define OVERLAY_ROW 10
+#define OVERLAY_BAR_X 170
+#define OVERLAY_BAR_MAX 140
+#define OVERLAY_US_SHIFT 8
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+} stage_totals_t;
+
+static const char *const stage_names[PROFILE_STAGE_COUNT] = {
+    "ray", "spr", "ui", "ply", "ai", "swap"
+};
+
+static uint32_t stage_start[PROFILE_STAGE_COUNT];
+static uint32_t frame_cycles[PROFILE_STAGE_COUNT];
+static uint32_t frame_log[LOG_FRAMES][PROFILE_STAGE_COUNT];
+static stage_totals_t totals[PROFILE_STAGE_COUNT];
+static uint32_t frame_count = 0;
+static int log_head = 0;
+static bool overlay_visible = false;
+
+void profile_init(void) {
+    memset(frame_cycles, 0, sizeof(frame_cycles));
+    memset(frame_log, 0, sizeof(frame_log));
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        totals[i].min = UINT32_MAX;
+        totals[i].max = 0;
+        totals[i].sum = 0;
+    }
+    frame_count = 0;
+    log_head = 0;
+
+    timer_Disable(PROFILE_TIMER);
+    timer_Set(PROFILE_TIMER, 0);
+    timer_Enable(PROFILE_TIMER, TIMER_CPU, TIMER_NOINT, TIMER_UP);
+}
+
+void profile_begin(profile_stage_t stage) {
+    stage_start[stage] = timer_Get(PROFILE_TIMER);
+}
+
+/* Several ticks can run per frame, so a stage accumulates until profile_frame_end(). */
+void profile_end(profile_stage_t stage) {
+    frame_cycles[stage] += timer_Get(PROFILE_TIMER) - stage_start[stage];
+}
+
+void profile_frame_end(void) {
+    uint32_t *entry = frame_log[log_head];
+
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        uint32_t us = frame_cycles[i] / CYCLES_PER_US;
+        entry[i] = us;
+        frame_cycles[i] = 0;
+
+        if (us < totals[i].min) totals[i].min = us;
+        if (us > totals[i].max) totals[i].max = us;
+        totals[i].sum += us;
+    }
+
+    log_head = (log_head + 1) % LOG_FRAMES;
+    frame_count++;
+}
+
+void profile_toggle_overlay(void) {
+    overlay_visible = !overlay_visible;
+}
+
+static int overlay_width(uint32_t us) {
+    uint32_t width = us >> OVERLAY_US_SHIFT;
+    return (width > OVERLAY_BAR_MAX) ? OVERLAY_BAR_MAX : (int)width;
+}
+
+void profile_draw_overlay(void) {
+    if (!overlay_visible || frame_count == 0) {
+        return;
+    }
+
+    int frames = (frame_count < WINDOW_FRAMES) ? (int)frame_count : WINDOW_FRAMES;
+
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        uint32_t min = UINT32_MAX;
+        uint32_t max = 0;
+        uint32_t sum = 0;
+        for (int f = 1; f <= frames; f++) {
+            uint32_t us = frame_log[(log_head + LOG_FRAMES - f) % LOG_FRAMES][i];
+            if (us < min) min = us;
+            if (us > max) max = us;
+            sum += us;
+        }
+        uint32_t avg = sum / frames;
+
+        int y = OVERLAY_Y + i * OVERLAY_ROW;
+        int min_x = overlay_width(min);
+        int max_x = overlay_width(max);
+        blit_fill_rect(OVERLAY_BAR_X, y, overlay_width(avg) + 1, 4, RAYCAST_COLOR_CROSSHAIR);
+        blit_hline(OVERLAY_BAR_X + min_x, y + 5, max_x - min_x + 1, 255);
+
+#if !BLIT_COLUMN_MAJOR
+        gfx_SetTextFGColor(255);
+        gfx_SetTextXY(OVERLAY_X, y);
+        gfx_PrintString(stage_names[i]);
+        gfx_SetTextXY(OVERLAY_X + 40, y);
+        gfx_PrintUInt(min, 5);
+        gfx_SetTextXY(OVERLAY_X + 80, y);
+        gfx_PrintUInt(avg, 5);
+        gfx_SetTextXY(OVERLAY_X + 120, y);
+        gfx_PrintUInt(max, 5);
+#endif
+    }
+}
+
+static void write_line(uint8_t handle, const char *line) {
+    ti_Write(line, strlen(line), 1, handle);
+}
+
+/* Writes run totals and the last LOG_FRAMES frames, in microseconds, as CSV text. */
+void profile_dump(void) {
+    char line[96];
+
+    if (frame_count == 0) {
+        return;
+    }
+
+    uint8_t handle = ti_Open(APPVAR_NAME, "w");
+    if (!handle) {
+        return;
+    }
+
+    write_line(handle, "stage,min,avg,max\n");
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        sprintf(line, "%s,%lu,%lu,%lu\n", stage_names[i],
+                (unsigned long)totals[i].min,
+                (unsigned long)(totals[i].sum / frame_count),
+                (unsigned long)totals[i].max);
+        write_line(handle, line);
+    }
+
+    write_line(handle, "frame,ray,spr,ui,ply,ai,swap\n");
+    int frames = (frame_count < LOG_FRAMES) ? (int)frame_count : LOG_FRAMES;
+    uint32_t first = frame_count - (uint32_t)frames;
+    for (int f = 0; f < frames; f++) {
+        const uint32_t *entry = frame_log[(log_head + LOG_FRAMES - frames + f) % LOG_FRAMES];
+        sprintf(line, "%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", (unsigned long)(first + f),
+                (unsigned long)entry[0], (unsigned long)entry[1], (unsigned long)entry[2],
+                (unsigned long)entry[3], (unsigned long)entry[4], (unsigned long)entry[5]);
+        write_line(handle, line);
+    }
+
+    ti_Close(handle);
+}
+#endif
@@ -0,0 +1,44 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 0
+#endif
+
+typedef enum {
+    PROFILE_RAYCAST,
+    PROFILE_SPRITES,
+    PROFILE_UI,
+    PROFILE_PLAYER,
+    PROFILE_ENEMY_AI,
+    PROFILE_SWAP,
+    PROFILE_STAGE_COUNT
+} profile_stage_t;
+
+#if PROFILE_ENABLE
+void profile_init(void);
+void profile_begin(profile_stage_t stage);
+void profile_end(profile_stage_t stage);
+void profile_frame_end(void);
+void profile_toggle_overlay(void);
+void profile_draw_overlay(void);
+void profile_dump(void);
+
+#define PROFILE_INIT() profile_init()
+#define PROFILE_BEGIN(stage) profile_begin(stage)
+#define PROFILE_END(stage) profile_end(stage)
+#define PROFILE_FRAME_END() profile_frame_end()
+#define PROFILE_TOGGLE_OVERLAY() profile_toggle_overlay()
+#define PROFILE_DRAW_OVERLAY() profile_draw_overlay()
+#define PROFILE_DUMP() profile_dump()
+#else
+#define PROFILE_INIT() ((void)0)
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END(stage) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_TOGGLE_OVERLAY() ((void)0)
+#define PROFILE_DRAW_OVERLAY() ((void)0)
+#define PROFILE_DUMP() ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,53 @@
+#include "projection.h"
+
+#define SCREEN_HEIGHT 240
+#define SHADE_NEAR_LIMIT FIXED_FROM_INT(4)
+#define SHADE_MID_LIMIT FIXED_FROM_INT(10)
+
+proj_entry_t projection_table[PROJ_ENTRY_COUNT];
+int projection_recip_table[ANGLE_QUARTER + 1];
+
+uint8_t projection_shade(fixed_t dist) {
+    if (dist < SHADE_NEAR_LIMIT) {
+        return PROJ_SHADE_NEAR;
+    }
+    if (dist < SHADE_MID_LIMIT) {
+        return PROJ_SHADE_MID;
+    }
+    return PROJ_SHADE_FAR;
+}
+
+static void fill_entry(proj_entry_t *entry, int32_t dist) {
+    if (dist < 1) dist = 1;
+
+    int32_t line_height = ((int32_t)SCREEN_HEIGHT << RAY_SHIFT) / dist;
+    if (line_height < 1) line_height = 1;
+    if (line_height > PROJ_HEIGHT_MAX) line_height = PROJ_HEIGHT_MAX;
+
+    int32_t draw_start = SCREEN_HEIGHT / 2 - line_height / 2;
+    int32_t draw_end = draw_start + line_height - 1;
+    if (draw_start < 0) draw_start = 0;
+    if (draw_end >= SCREEN_HEIGHT) draw_end = SCREEN_HEIGHT - 1;
+
+    entry->line_height = (uint16_t)line_height;
+    entry->draw_start = (uint8_t)draw_start;
+    entry->draw_end = (uint8_t)draw_end;
+    entry->shade = projection_shade((fixed_t)(dist >> (RAY_SHIFT - FIXED_SHIFT)));
+}
+
+void projection_init(void) {
+    for (int i = 0; i < PROJ_NEAR_ENTRIES; i++) {
+        int32_t dist = ((int32_t)i << PROJ_NEAR_SHIFT) + (1 << (PROJ_NEAR_SHIFT - 1));
+        fill_entry(&projection_table[i], dist);
+    }
+    for (int i = 0; i <= PROJ_FAR_ENTRIES; i++) {
+        int32_t dist = PROJ_NEAR_LIMIT + ((int32_t)i << PROJ_FAR_SHIFT) + (1 << (PROJ_FAR_SHIFT - 1));
+        fill_entry(&projection_table[PROJ_NEAR_ENTRIES + i], dist);
+    }
+
+    for (int a = 0; a < ANGLE_QUARTER; a++) {
+        trig_t c = angle_sin_table[ANGLE_QUARTER - a];
+        projection_recip_table[a] = (int)(((int32_t)RAY_ONE << TRIG_SHIFT) / c);
+    }
+    projection_recip_table[ANGLE_QUARTER] = PROJ_RECIP_INF;
+}
@@ -0,0 +1,61 @@
+#ifndef PROJECTION_H
+#define PROJECTION_H
+
+#include <stdint.h>
+#include "fixed.h"
+#include "angle.h"
+
+#define PROJ_SHADE_NEAR 0
+#define PROJ_SHADE_MID 1
+#define PROJ_SHADE_FAR 2
+
+#define PROJ_NEAR_SHIFT 4
+#define PROJ_FAR_SHIFT 7
+#define PROJ_NEAR_LIMIT (4 << RAY_SHIFT)
+#define PROJ_MAX_DIST (20 << RAY_SHIFT)
+#define PROJ_NEAR_ENTRIES (PROJ_NEAR_LIMIT >> PROJ_NEAR_SHIFT)
+#define PROJ_FAR_ENTRIES ((PROJ_MAX_DIST - PROJ_NEAR_LIMIT) >> PROJ_FAR_SHIFT)
+#define PROJ_ENTRY_COUNT (PROJ_NEAR_ENTRIES + PROJ_FAR_ENTRIES + 1)
+
+#define PROJ_RECIP_INF 0x7FFFFF
+/* Tallest projected slice, a wall about 0.23 cells away; nearer walls keep this height and still fill the column. */
+#define PROJ_HEIGHT_MAX 1023
+
+typedef struct {
+    uint16_t line_height;
+    uint8_t draw_start;
+    uint8_t draw_end;
+    uint8_t shade;
+} proj_entry_t;
+
+extern proj_entry_t projection_table[PROJ_ENTRY_COUNT];
+extern int projection_recip_table[ANGLE_QUARTER + 1];
+
+void projection_init(void);
+uint8_t projection_shade(fixed_t dist);
+
+/* dist is a perpendicular wall distance in RAY_SHIFT units. */
+static inline const proj_entry_t *projection_lookup(int dist) {
+    if (dist < PROJ_NEAR_LIMIT) {
+        return &projection_table[dist >> PROJ_NEAR_SHIFT];
+    }
+    if (dist >= PROJ_MAX_DIST) {
+        return &projection_table[PROJ_ENTRY_COUNT - 1];
+    }
+    return &projection_table[PROJ_NEAR_ENTRIES + ((dist - PROJ_NEAR_LIMIT) >> PROJ_FAR_SHIFT)];
+}
+
+/* |1 / cos(a)| in RAY_SHIFT units, PROJ_RECIP_INF where cos(a) is zero. */
+static inline int projection_recip_cos(angle_t a) {
+    a &= ANGLE_HALF - 1;
+    if (a > ANGLE_QUARTER) {
+        a = ANGLE_HALF - a;
+    }
+    return projection_recip_table[a];
+}
+
+static inline int projection_recip_sin(angle_t a) {
+    return projection_recip_cos((angle_t)(a - ANGLE_QUARTER));
+}
+
+#endif
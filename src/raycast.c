@@ -2,17 +2,50 @@
 #include "player.h"
 #include "level.h"
 #include "enemy.h"
+#include "fixed.h"
+#include "angle.h"
+#include "projection.h"
+#include "blit.h"
+#include "sprite.h"
+#include "texture.h"
 #include <graphx.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
-#include <string.h>
 
 #define SCREEN_WIDTH 320
 #define SCREEN_HEIGHT 240
 #define FOV (M_PI / 3.0f)
 #define MAX_DEPTH 20.0f
 #define RAY_STEP 5
+#define MAX_STEPS ((int)(MAX_DEPTH * 4.0f))
+
+#ifndef RAYCAST_FLOAT_DDA
+#define RAYCAST_FLOAT_DDA 0
+#endif
+
+#ifndef RAYCAST_REFINE
+#define RAYCAST_REFINE 0
+#endif
+
+#ifndef RAYCAST_SKIP
+#define RAYCAST_SKIP 1
+#endif
+
+#ifndef RAYCAST_TEXTURED
+#define RAYCAST_TEXTURED 1
+#endif
+
+#define REFINE_SHIFT 3
+#define REFINE_SHIFT_MAX 4
+
+#define DEPTH_FAR FIXED_FROM_INT((int)MAX_DEPTH)
+#define SPRITE_DEPTH_BIAS (FIXED_ONE / 10)
+
+#define RAY_MAX_DIST ((int)MAX_DEPTH << RAY_SHIFT)
+#define SPRITE_NEAR_DIST (RAY_ONE / 10)
+#define RAY_FAR (64 << RAY_SHIFT)
+#define RAY_RECIP_COARSE_SHIFT 6
 
 #define COLOR_BLACK 0
 #define COLOR_SKY_NEAR 1
@@ -37,270 +70,714 @@
 #define COLOR_CROSSHAIR 20
 #define COLOR_WEAPON_PRIMARY 21
 #define COLOR_WEAPON_ACCENT 22
-#define PALETTE_ENTRY_COUNT 23
+#define COLOR_WALL_DARKER 23
+#define COLOR_WALL_DARKEST 24
+#define COLOR_WALL_SHADE_DARKER 25
+#define COLOR_WALL_SHADE_DARKEST 26
+#define COLOR_DOOR_DARKER 27
+#define COLOR_DOOR_DARKEST 28
+#define COLOR_EXIT_DARKER 29
+#define COLOR_EXIT_DARKEST 30
+#define PALETTE_ENTRY_COUNT 31
+
+#define RAMP_LENGTH (3 + TEX_TONES - 1)
 
 typedef struct {
-    uint8_t near;
-    uint8_t mid;
-    uint8_t far;
+    uint8_t shade[3];
 } shade_triplet_t;
 
-static float depth_buffer[SCREEN_WIDTH];
-static float depth_template[SCREEN_WIDTH];
+typedef struct {
+    bool hit;
+    bool vertical;
+    uint8_t cell;
+    int map_x, map_y;
+    int perp;
+    uint8_t draw_start;
+    uint8_t draw_end;
+    uint8_t shade;
+#if RAYCAST_TEXTURED
+    uint8_t tex_x;
+    uint16_t line_height;
+#endif
+} ray_hit_t;
+
+typedef struct {
+    int x;
+    int width;
+    uint8_t wall_start;
+    uint8_t wall_end;
+    uint8_t ceiling_color;
+    uint8_t wall_color;
+    uint8_t floor_color;
+#if RAYCAST_TEXTURED
+    const uint8_t *texels;
+    const uint8_t *colors;
+    int tex_pos;
+    int tex_step;
+#endif
+} span_t;
 
-static float cos_lookup[SCREEN_WIDTH];
-static float sin_lookup[SCREEN_WIDTH];
+typedef struct {
+    int x;
+    fixed_t depth;
+} depth_run_t;
+
+typedef struct {
+    fixed_t depth;
+    uint8_t enemy;
+    enemy_type_t type;
+    sprite_pick_t pick;
+    int x, y;
+    int left, right;
+} sprite_t;
+
+/* Run-length depth buffer: run i covers columns [x, depth_runs[i + 1].x); a sentinel ends the list at SCREEN_WIDTH. */
+static depth_run_t depth_runs[SCREEN_WIDTH + 1];
+static int depth_run_count;
+
+static sprite_t sprites[MAX_ENEMIES];
+static uint8_t nearby[MAX_ENEMIES];
+
+static int16_t col_angle[SCREEN_WIDTH + 1];
+
+#if RAYCAST_FLOAT_DDA
+static float cos_lookup[SCREEN_WIDTH + 1];
+static float sin_lookup[SCREEN_WIDTH + 1];
+static float view_x, view_y;
+static float view_cos, view_sin;
+#else
+static trig_t col_cos[SCREEN_WIDTH + 1];
+static int view_x, view_y;
+static angle_t view_angle;
+#endif
+
+#if RAYCAST_REFINE
+static ray_hit_t column_rays[SCREEN_WIDTH + 1];
+#endif
+
+static int ray_step = RAY_STEP;
+static int view_top = 0;
+static int view_bottom = SCREEN_HEIGHT;
+#if RAYCAST_REFINE
+static int refine_shift = REFINE_SHIFT;
+#endif
+
+static span_t pending_span;
+static raycast_stats_t stats;
 
 static uint16_t palette_data[PALETTE_ENTRY_COUNT];
 static bool palette_ready = false;
 
 static const shade_triplet_t wall_shades[2] = {
-    { COLOR_WALL_LIGHT, COLOR_WALL_MEDIUM, COLOR_WALL_DARK },
-    { COLOR_WALL_SHADE_LIGHT, COLOR_WALL_SHADE_MEDIUM, COLOR_WALL_SHADE_DARK }
+    {{ COLOR_WALL_LIGHT, COLOR_WALL_MEDIUM, COLOR_WALL_DARK }},
+    {{ COLOR_WALL_SHADE_LIGHT, COLOR_WALL_SHADE_MEDIUM, COLOR_WALL_SHADE_DARK }}
 };
 
 static const shade_triplet_t door_shades = {
-    COLOR_DOOR_LIGHT, COLOR_DOOR_MID, COLOR_DOOR_DARK
+    { COLOR_DOOR_LIGHT, COLOR_DOOR_MID, COLOR_DOOR_DARK }
 };
 
 static const shade_triplet_t exit_shades = {
-    COLOR_EXIT_LIGHT, COLOR_EXIT_MID, COLOR_EXIT_DARK
+    { COLOR_EXIT_LIGHT, COLOR_EXIT_MID, COLOR_EXIT_DARK }
+};
+
+#if RAYCAST_TEXTURED
+/* Per material, the three distance shades followed by darker steps for the texture tones. */
+static const uint8_t wall_ramps[4][RAMP_LENGTH] = {
+    { COLOR_WALL_LIGHT, COLOR_WALL_MEDIUM, COLOR_WALL_DARK, COLOR_WALL_DARKER, COLOR_WALL_DARKEST },
+    { COLOR_WALL_SHADE_LIGHT, COLOR_WALL_SHADE_MEDIUM, COLOR_WALL_SHADE_DARK,
+      COLOR_WALL_SHADE_DARKER, COLOR_WALL_SHADE_DARKEST },
+    { COLOR_DOOR_LIGHT, COLOR_DOOR_MID, COLOR_DOOR_DARK, COLOR_DOOR_DARKER, COLOR_DOOR_DARKEST },
+    { COLOR_EXIT_LIGHT, COLOR_EXIT_MID, COLOR_EXIT_DARK, COLOR_EXIT_DARKER, COLOR_EXIT_DARKEST }
 };
+#endif
 
 static const shade_triplet_t floor_shades = {
-    COLOR_FLOOR_NEAR, COLOR_FLOOR_MID, COLOR_FLOOR_FAR
+    { COLOR_FLOOR_NEAR, COLOR_FLOOR_MID, COLOR_FLOOR_FAR }
 };
 
 static const shade_triplet_t ceiling_shades = {
-    COLOR_SKY_NEAR, COLOR_SKY_MID, COLOR_SKY_FAR
+    { COLOR_SKY_NEAR, COLOR_SKY_MID, COLOR_SKY_FAR }
 };
 
-static inline uint8_t select_shade(const shade_triplet_t *set, float dist) {
-    if (dist < 4.0f) {
-        return set->near;
-    }
-    if (dist < 10.0f) {
-        return set->mid;
-    }
-    return set->far;
+static inline bool span_matches(const span_t *a, const span_t *b) {
+    bool same = a->wall_start == b->wall_start &&
+                a->wall_end == b->wall_end &&
+                a->wall_color == b->wall_color &&
+                a->ceiling_color == b->ceiling_color &&
+                a->floor_color == b->floor_color;
+#if RAYCAST_TEXTURED
+    same = same && a->texels == b->texels && a->tex_pos == b->tex_pos && a->tex_step == b->tex_step;
+#endif
+    return same;
 }
 
-static inline void draw_segment(int x, int y1, int y2, uint8_t color) {
-    if (y2 < y1) {
+static void span_flush(void) {
+    if (pending_span.width == 0) {
         return;
     }
-    gfx_SetColor(color);
-    gfx_VertLine(x, y1, y2);
+#if RAYCAST_TEXTURED
+    if (pending_span.texels) {
+        blit_textured_column(pending_span.x, pending_span.width,
+                             pending_span.wall_start, pending_span.wall_end,
+                             pending_span.ceiling_color, pending_span.floor_color,
+                             pending_span.texels, pending_span.colors,
+                             pending_span.tex_pos, pending_span.tex_step);
+    } else
+#endif
+    blit_column(pending_span.x, pending_span.width,
+                pending_span.wall_start, pending_span.wall_end,
+                pending_span.ceiling_color, pending_span.wall_color, pending_span.floor_color);
+    stats.spans_drawn++;
+    stats.column_pixels += pending_span.width * (view_bottom - view_top);
+    pending_span.width = 0;
 }
 
-static inline void depth_buffer_reset(void) {
-    memcpy(depth_buffer, depth_template, sizeof(depth_buffer));
+static void span_push(const span_t *span) {
+    if (pending_span.width > 0 && span_matches(&pending_span, span)) {
+        pending_span.width += span->width;
+        stats.spans_merged++;
+        return;
+    }
+    span_flush();
+    pending_span = *span;
 }
 
-void raycast_render(void) {
-    float px = player_get_x();
-    float py = player_get_y();
-    float angle = player_get_angle();
-
-    depth_buffer_reset();
+#if RAYCAST_FLOAT_DDA
+static void cast_ray(int sample, ray_hit_t *out) {
+    float px = view_x;
+    float py = view_y;
+    float rel_cos = cos_lookup[sample];
+    float rel_sin = sin_lookup[sample];
+
+    float dx = view_cos * rel_cos - view_sin * rel_sin;
+    float dy = view_sin * rel_cos + view_cos * rel_sin;
+
+    float step_x = (dx > 0.0f) ? 1.0f : -1.0f;
+    float step_y = (dy > 0.0f) ? 1.0f : -1.0f;
+
+    float delta_x = (fabsf(dx) > 1e-6f) ? fabsf(1.0f / dx) : 1e30f;
+    float delta_y = (fabsf(dy) > 1e-6f) ? fabsf(1.0f / dy) : 1e30f;
+
+    int map_x = (int)px;
+    int map_y = (int)py;
+    if (px < 0.0f) map_x--;
+    if (py < 0.0f) map_y--;
+
+    float side_dist_x = (dx < 0.0f)
+                            ? (px - (float)map_x) * delta_x
+                            : ((float)map_x + 1.0f - px) * delta_x;
+    float side_dist_y = (dy < 0.0f)
+                            ? (py - (float)map_y) * delta_y
+                            : ((float)map_y + 1.0f - py) * delta_y;
+
+    out->hit = false;
+
+    for (int step = 0; step < MAX_STEPS; step++) {
+        stats.dda_steps++;
+        if (side_dist_x < side_dist_y) {
+            if (side_dist_x >= MAX_DEPTH) {
+                return;
+            }
+            side_dist_x += delta_x;
+            map_x += (int)step_x;
+            out->vertical = false;
+        } else {
+            if (side_dist_y >= MAX_DEPTH) {
+                return;
+            }
+            side_dist_y += delta_y;
+            map_y += (int)step_y;
+            out->vertical = true;
+        }
 
-    gfx_SetColor(COLOR_SKY_FAR);
-    gfx_FillScreen(COLOR_SKY_FAR);
+        int cell = LEVEL_CELL(map_x, map_y);
+        if (cell != LEVEL_CELL_EMPTY) {
+            float dist;
+            if (out->vertical) {
+                dist = ((float)map_y - py + (1.0f - step_y) * 0.5f) / dy;
+            } else {
+                dist = ((float)map_x - px + (1.0f - step_x) * 0.5f) / dx;
+            }
+            if (dist <= 0.0f || dist >= MAX_DEPTH) {
+                return;
+            }
 
-    float cos_angle = cosf(angle);
-    float sin_angle = sinf(angle);
+#if RAYCAST_TEXTURED
+            float wall = out->vertical ? px + dist * dx : py + dist * dy;
+            int u = (int)((wall - floorf(wall)) * RAY_ONE);
+            if (out->vertical ? dy < 0.0f : dx > 0.0f) u = RAY_ONE - 1 - u;
+            out->tex_x = (uint8_t)(u >> (RAY_SHIFT - TEX_SHIFT));
+#endif
 
-    const int max_steps = (int)(MAX_DEPTH * 4.0f);
-    const int screen_half = SCREEN_HEIGHT / 2;
+            float perp_dist = fabsf(dist * rel_cos);
+            if (perp_dist < 0.001f) {
+                perp_dist = 0.001f;
+            }
 
-    for (int x = 0; x < SCREEN_WIDTH; x += RAY_STEP) {
-        int sample = x + (RAY_STEP / 2);
-        if (sample >= SCREEN_WIDTH) {
-            sample = SCREEN_WIDTH - 1;
+            out->hit = true;
+            out->cell = (uint8_t)cell;
+            out->map_x = map_x;
+            out->map_y = map_y;
+            out->perp = (int)(perp_dist * RAY_ONE);
+            const proj_entry_t *proj = projection_lookup(out->perp);
+            out->draw_start = proj->draw_start;
+            out->draw_end = proj->draw_end;
+            out->shade = projection_shade(FIXED_FROM_FLOAT(perp_dist));
+#if RAYCAST_TEXTURED
+            out->line_height = proj->line_height;
+#endif
+            return;
         }
+    }
+}
+#else
+static inline int ray_side_dist(int frac, int recip, int *delta) {
+    if (recip <= RAY_FAR) {
+        *delta = recip;
+        return (int)(((int32_t)frac * recip) >> RAY_SHIFT);
+    }
 
-        float rel_cos = cos_lookup[sample];
-        float rel_sin = sin_lookup[sample];
-
-        float dx = cos_angle * rel_cos - sin_angle * rel_sin;
-        float dy = sin_angle * rel_cos + cos_angle * rel_sin;
-
-        float step_x = (dx > 0.0f) ? 1.0f : -1.0f;
-        float step_y = (dy > 0.0f) ? 1.0f : -1.0f;
-
-        float delta_x = (fabsf(dx) > 1e-6f) ? fabsf(1.0f / dx) : 1e30f;
-        float delta_y = (fabsf(dy) > 1e-6f) ? fabsf(1.0f / dy) : 1e30f;
-
-        int map_x = (int)px;
-        int map_y = (int)py;
-        if (px < 0.0f) map_x--;
-        if (py < 0.0f) map_y--;
-
-        float side_dist_x = (dx < 0.0f)
-                                ? (px - (float)map_x) * delta_x
-                                : ((float)map_x + 1.0f - px) * delta_x;
-        float side_dist_y = (dy < 0.0f)
-                                ? (py - (float)map_y) * delta_y
-                                : ((float)map_y + 1.0f - py) * delta_y;
-
-        int map_xi = map_x;
-        int map_yi = map_y;
-        bool hit = false;
-        bool hit_vertical = false;
-        int hit_cell = LEVEL_CELL_WALL;
-        float dist = MAX_DEPTH;
-
-        for (int step = 0; step < max_steps; step++) {
-            if (side_dist_x < side_dist_y) {
-                side_dist_x += delta_x;
-                map_xi += (int)step_x;
-                hit_vertical = false;
-            } else {
-                side_dist_y += delta_y;
-                map_yi += (int)step_y;
-                hit_vertical = true;
+    *delta = RAY_FAR;
+    int32_t side = ((int32_t)frac * (recip >> RAY_RECIP_COARSE_SHIFT))
+                   >> (RAY_SHIFT - RAY_RECIP_COARSE_SHIFT);
+    return (side < RAY_FAR) ? (int)side : RAY_FAR;
+}
+
+#if RAYCAST_SKIP
+/* Grid lines crossed along one axis by the time the ray reaches target, at most reach. */
+static inline int skip_count(int p, int target, trig_t dir, int cell, bool pos, int reach) {
+    int end = (p + (int)(((int32_t)target * dir) >> TRIG_SHIFT)) >> RAY_SHIFT;
+    int n = pos ? end - cell : cell - end;
+    if (n < 0) return 0;
+    return (n < reach) ? n : reach;
+}
+#endif
+
+static void cast_ray(int sample, ray_hit_t *out) {
+    int px = view_x;
+    int py = view_y;
+    angle_t ray_angle = (angle_t)(view_angle + col_angle[sample]) & ANGLE_MASK;
+
+    trig_t dir_x = angle_cos(ray_angle);
+    trig_t dir_y = angle_sin(ray_angle);
+    bool pos_x = dir_x > 0;
+    bool pos_y = dir_y > 0;
+    int step_x = pos_x ? 1 : -1;
+    int step_y = pos_y ? 1 : -1;
+
+    int map_x = px >> RAY_SHIFT;
+    int map_y = py >> RAY_SHIFT;
+    int frac_x = px & (RAY_ONE - 1);
+    int frac_y = py & (RAY_ONE - 1);
+    if (pos_x) frac_x = RAY_ONE - frac_x;
+    if (pos_y) frac_y = RAY_ONE - frac_y;
+
+    int delta_x, delta_y;
+    int side_dist_x = ray_side_dist(frac_x, projection_recip_cos(ray_angle), &delta_x);
+    int side_dist_y = ray_side_dist(frac_y, projection_recip_sin(ray_angle), &delta_y);
+
+    const uint8_t *cell_ptr = &LEVEL_CELL(map_x, map_y);
+    int row_step = pos_y ? LEVEL_STRIDE : -LEVEL_STRIDE;
+
+    int dist = 0;
+    out->hit = false;
+
+    for (int step = 0; step < MAX_STEPS; step++) {
+        stats.dda_steps++;
+#if RAYCAST_SKIP
+        /*
+         * Every cell within Chebyshev radius reach of this one is empty, so the
+         * ray can advance reach units without testing cells. The crossing
+         * counts are then pulled back until they form a state the plain DDA
+         * would also pass through, which keeps hits bit-identical.
+         */
+        int reach = level_dist[cell_ptr - level_window] - 1;
+        if (reach > 0) {
+            int target = dist + (reach << RAY_SHIFT);
+            if (target >= RAY_MAX_DIST) {
+                return;
             }
 
-            int cell = level_get_cell(map_xi, map_yi);
-            if (cell == LEVEL_CELL_WALL || cell == LEVEL_CELL_DOOR || cell == LEVEL_CELL_EXIT) {
-                hit = true;
-                hit_cell = cell;
-                float map_xf = (float)map_xi;
-                float map_yf = (float)map_yi;
-                if (hit_vertical) {
-                    dist = (map_yf - py + (1.0f - step_y) * 0.5f) / dy;
+            int n_x = skip_count(px, target, dir_x, map_x, pos_x, reach);
+            int n_y = skip_count(py, target, dir_y, map_y, pos_y, reach);
+            side_dist_x += n_x * delta_x;
+            side_dist_y += n_y * delta_y;
+            for (;;) {
+                if (n_x > 0 && side_dist_x - delta_x >= side_dist_y) {
+                    n_x--;
+                    side_dist_x -= delta_x;
+                } else if (n_y > 0 && side_dist_y - delta_y > side_dist_x) {
+                    n_y--;
+                    side_dist_y -= delta_y;
                 } else {
-                    dist = (map_xf - px + (1.0f - step_x) * 0.5f) / dx;
+                    break;
                 }
-                break;
             }
+
+            if (!pos_x) n_x = -n_x;
+            if (!pos_y) n_y = -n_y;
+            map_x += n_x;
+            map_y += n_y;
+            cell_ptr += n_x + n_y * LEVEL_STRIDE;
+            stats.dda_jumps++;
+        }
+#endif
+        if (side_dist_x < side_dist_y) {
+            dist = side_dist_x;
+            side_dist_x += delta_x;
+            map_x += step_x;
+            cell_ptr += step_x;
+            out->vertical = false;
+        } else {
+            dist = side_dist_y;
+            side_dist_y += delta_y;
+            map_y += step_y;
+            cell_ptr += row_step;
+            out->vertical = true;
         }
 
-        float perp_dist = MAX_DEPTH;
-        bool has_wall = false;
-        int draw_start = screen_half;
-        int draw_end = screen_half - 1;
-        uint8_t wall_color = COLOR_WALL_MEDIUM;
+        if (dist >= RAY_MAX_DIST) {
+            return;
+        }
 
-        if (hit && dist > 0.0f && dist < MAX_DEPTH) {
-            perp_dist = fabsf(dist * rel_cos);
-            if (perp_dist < 0.001f) {
-                perp_dist = 0.001f;
+        int cell = *cell_ptr;
+        if (cell != LEVEL_CELL_EMPTY) {
+            if (dist <= 0) {
+                return;
             }
 
-            int line_height = (int)(SCREEN_HEIGHT / perp_dist);
-            if (line_height < 1) line_height = 1;
+            int perp = (int)(((int32_t)dist * col_cos[sample]) >> TRIG_SHIFT);
+            const proj_entry_t *proj = projection_lookup(perp);
+
+            out->hit = true;
+            out->cell = (uint8_t)cell;
+            out->map_x = map_x;
+            out->map_y = map_y;
+            out->perp = perp;
+            out->draw_start = proj->draw_start;
+            out->draw_end = proj->draw_end;
+            out->shade = proj->shade;
+#if RAYCAST_TEXTURED
+            int u;
+            if (out->vertical) {
+                u = (px + (int)(((int32_t)dist * dir_x) >> TRIG_SHIFT)) & (RAY_ONE - 1);
+                if (!pos_y) u = RAY_ONE - 1 - u;
+            } else {
+                u = (py + (int)(((int32_t)dist * dir_y) >> TRIG_SHIFT)) & (RAY_ONE - 1);
+                if (pos_x) u = RAY_ONE - 1 - u;
+            }
+            out->tex_x = (uint8_t)(u >> (RAY_SHIFT - TEX_SHIFT));
+            out->line_height = proj->line_height;
+#endif
+            return;
+        }
+    }
+}
+#endif
+
+static void emit_column(int x, int width, const ray_hit_t *ray) {
+    fixed_t perp_dist = DEPTH_FAR;
+    uint8_t shade = PROJ_SHADE_FAR;
+    span_t span;
+    span.x = x;
+    span.width = width;
+    span.wall_start = SCREEN_HEIGHT / 2;
+    span.wall_end = SCREEN_HEIGHT / 2 - 1;
+    span.wall_color = COLOR_WALL_MEDIUM;
+#if RAYCAST_TEXTURED
+    span.texels = NULL;
+    span.colors = NULL;
+    span.tex_pos = 0;
+    span.tex_step = 0;
+#endif
+
+    if (ray->hit) {
+        perp_dist = ray->perp >> (RAY_SHIFT - FIXED_SHIFT);
+        if (perp_dist < 1) {
+            perp_dist = 1;
+        }
+        span.wall_start = (ray->draw_start < view_top) ? view_top : ray->draw_start;
+        span.wall_end = (ray->draw_end >= view_bottom) ? view_bottom - 1 : ray->draw_end;
+        shade = ray->shade;
+
+        const shade_triplet_t *shade_set = &wall_shades[ray->vertical ? 1 : 0];
+        if (ray->cell == LEVEL_CELL_DOOR) {
+            shade_set = &door_shades;
+        } else if (ray->cell == LEVEL_CELL_EXIT) {
+            shade_set = &exit_shades;
+        }
 
-            draw_start = screen_half - (line_height / 2);
-            draw_end = draw_start + line_height - 1;
+        span.wall_color = shade_set->shade[shade];
 
-            if (draw_start < 0) draw_start = 0;
-            if (draw_end >= SCREEN_HEIGHT) draw_end = SCREEN_HEIGHT - 1;
+#if RAYCAST_TEXTURED
+        int ramp = (ray->cell == LEVEL_CELL_WALL) ? (ray->vertical ? 1 : 0) : ray->cell;
+        int top = SCREEN_HEIGHT / 2 - ray->line_height / 2;
+        span.texels = texture_column(ray->cell, ray->tex_x);
+        span.colors = &wall_ramps[ramp][shade];
+        span.tex_step = texture_step(ray->line_height);
+        span.tex_pos = (span.wall_start > top) ? (span.wall_start - top) * span.tex_step : 0;
+#endif
+    }
 
-            const shade_triplet_t *shade_set = &wall_shades[hit_vertical ? 1 : 0];
-            if (hit_cell == LEVEL_CELL_DOOR) {
-                shade_set = &door_shades;
-            } else if (hit_cell == LEVEL_CELL_EXIT) {
-                shade_set = &exit_shades;
-            }
+    span.ceiling_color = ceiling_shades.shade[shade];
+    span.floor_color = floor_shades.shade[shade];
 
-            wall_color = select_shade(shade_set, perp_dist);
-            has_wall = true;
-        }
+    if (depth_run_count == 0 || depth_runs[depth_run_count - 1].depth != perp_dist) {
+        depth_runs[depth_run_count].x = x;
+        depth_runs[depth_run_count].depth = perp_dist;
+        depth_run_count++;
+    }
 
-        int ceiling_end = has_wall ? draw_start - 1 : screen_half - 1;
-        uint8_t ceiling_color = select_shade(&ceiling_shades, has_wall ? perp_dist : MAX_DEPTH);
-        uint8_t floor_color = select_shade(&floor_shades, has_wall ? perp_dist : MAX_DEPTH);
+    span_push(&span);
+}
 
-        for (int col = 0; col < RAY_STEP && (x + col) < SCREEN_WIDTH; col++) {
-            int column = x + col;
+static inline void trace_column(int sample, ray_hit_t *ray) {
+    stats.rays_cast++;
+    cast_ray(sample, ray);
+}
 
-            if (has_wall) {
-                depth_buffer[column] = perp_dist;
-            } else {
-                depth_buffer[column] = MAX_DEPTH;
-            }
+#if RAYCAST_REFINE
+static inline bool rays_share_face(const ray_hit_t *a, const ray_hit_t *b) {
+    if (!a->hit || !b->hit) {
+        return a->hit == b->hit;
+    }
+    return a->map_x == b->map_x && a->map_y == b->map_y && a->vertical == b->vertical;
+}
 
-            if (ceiling_end >= 0) {
-                draw_segment(column, 0, ceiling_end, ceiling_color);
-            }
+/* Fills the columns strictly between a and b; b - a must be a power of two. */
+static void refine_columns(int a, int b, int shift) {
+    if (shift == 0) {
+        return;
+    }
 
-            if (has_wall) {
-                draw_segment(column, draw_start, draw_end, wall_color);
-            }
+    const ray_hit_t *left = &column_rays[a];
+    const ray_hit_t *right = &column_rays[b];
 
-            int floor_start = has_wall ? draw_end + 1 : screen_half;
-            if (floor_start < SCREEN_HEIGHT) {
-                draw_segment(column, floor_start, SCREEN_HEIGHT - 1, floor_color);
-            }
+    if (!rays_share_face(left, right)) {
+        int mid = a + ((b - a) >> 1);
+        trace_column(mid, &column_rays[mid]);
+        refine_columns(a, mid, shift - 1);
+        refine_columns(mid, b, shift - 1);
+        return;
+    }
+
+    int span = right->perp - left->perp;
+    for (int x = a + 1; x < b; x++) {
+        ray_hit_t *ray = &column_rays[x];
+        *ray = *left;
+        if (left->hit) {
+            ray->perp = left->perp + ((span * (x - a)) >> shift);
+            const proj_entry_t *proj = projection_lookup(ray->perp);
+            ray->draw_start = proj->draw_start;
+            ray->draw_end = proj->draw_end;
+            ray->shade = proj->shade;
+#if RAYCAST_TEXTURED
+            ray->tex_x = (uint8_t)(left->tex_x + (((right->tex_x - left->tex_x) * (x - a)) >> shift));
+            ray->line_height = proj->line_height;
+#endif
         }
+        stats.columns_interpolated++;
     }
 }
 
-void raycast_render_enemies(void) {
-    float px = player_get_x();
-    float py = player_get_y();
-    float pangle = player_get_angle();
+static void render_columns(void) {
+    int refine_step = 1 << refine_shift;
+    for (int x = 0; x <= SCREEN_WIDTH; x += refine_step) {
+        trace_column(x, &column_rays[x]);
+    }
+    for (int x = 0; x < SCREEN_WIDTH; x += refine_step) {
+        refine_columns(x, x + refine_step, refine_shift);
+    }
+    for (int x = 0; x < SCREEN_WIDTH; x++) {
+        emit_column(x, 1, &column_rays[x]);
+    }
+    stats.columns_filled = SCREEN_WIDTH;
+}
+#else
+static void render_columns(void) {
+    for (int x = 0; x < SCREEN_WIDTH; x += ray_step) {
+        int sample = x + (ray_step / 2);
+        if (sample >= SCREEN_WIDTH) {
+            sample = SCREEN_WIDTH - 1;
+        }
 
-    float cos_angle = cosf(-pangle);
-    float sin_angle = sinf(-pangle);
+        int width = ray_step;
+        if (x + width > SCREEN_WIDTH) {
+            width = SCREEN_WIDTH - x;
+        }
 
-    enemy_t *enemies = enemy_get_list();
-    int enemy_count = enemy_get_count();
+        ray_hit_t ray;
+        trace_column(sample, &ray);
+        emit_column(x, width, &ray);
+    }
+    stats.columns_filled = SCREEN_WIDTH;
+}
+#endif
 
-    for (int i = 0; i < enemy_count; i++) {
-        enemy_t *e = &enemies[i];
-        if (!e->active) {
-            continue;
-        }
+void raycast_render(void) {
+    angle_t angle = player_get_view_angle();
+#if RAYCAST_FLOAT_DDA
+    view_x = player_get_view_x();
+    view_y = player_get_view_y();
+    view_cos = angle_cos(angle) / (float)TRIG_ONE;
+    view_sin = angle_sin(angle) / (float)TRIG_ONE;
+    level_focus((int)view_x, (int)view_y);
+#else
+    view_x = (int)(player_get_view_x() * RAY_ONE);
+    view_y = (int)(player_get_view_y() * RAY_ONE);
+    view_angle = angle;
+    level_focus(view_x >> RAY_SHIFT, view_y >> RAY_SHIFT);
+#endif
+
+    depth_run_count = 0;
+
+    blit_begin(COLOR_SKY_FAR);
+
+    stats.rays_cast = 0;
+    stats.dda_steps = 0;
+    stats.dda_jumps = 0;
+    stats.columns_filled = 0;
+    stats.columns_interpolated = 0;
+    stats.spans_drawn = 0;
+    stats.spans_merged = 0;
+    stats.column_pixels = 0;
+    pending_span.width = 0;
+
+    render_columns();
+    span_flush();
+    depth_runs[depth_run_count].x = SCREEN_WIDTH;
+}
 
-        float dx = e->x - px;
-        float dy = e->y - py;
+/* In refine mode the step is rounded up to the power-of-two sparse spacing. */
+void raycast_set_resolution(int step, int view_height) {
+    if (step < 1) step = 1;
+    if (view_height < 2) view_height = 2;
+    if (view_height > SCREEN_HEIGHT) view_height = SCREEN_HEIGHT;
+
+    ray_step = step;
+#if RAYCAST_REFINE
+    refine_shift = 0;
+    while ((1 << refine_shift) < step && refine_shift < REFINE_SHIFT_MAX) {
+        refine_shift++;
+    }
+#endif
 
-        float transform_x = dx * cos_angle - dy * sin_angle;
-        float transform_y = dx * sin_angle + dy * cos_angle;
+    view_top = (SCREEN_HEIGHT - view_height) / 2;
+    view_bottom = view_top + view_height;
+    blit_set_view(view_top, view_bottom, COLOR_BLACK);
+}
 
-        if (transform_y <= 0.1f || transform_y >= MAX_DEPTH) {
-            continue;
-        }
+const raycast_stats_t *raycast_get_stats(void) {
+    return &stats;
+}
 
-        float inv_transform_y = 1.0f / transform_y;
-        int sprite_screen_x = (int)((SCREEN_WIDTH / 2) * (1.0f + transform_x * inv_transform_y));
+static inline void sprite_strip(const sprite_t *s, int a, int b) {
+    sprite_blit(s->type, s->pick, s->x, s->y, a, b);
+}
 
-        int sprite_height = (int)(SCREEN_HEIGHT * inv_transform_y);
-        int sprite_width = sprite_height;
+/* Walks the depth runs under the sprite; consecutive visible runs become one strip, occluded runs cost one compare. */
+static bool sprite_draw(const sprite_t *s) {
+    fixed_t limit = s->depth - SPRITE_DEPTH_BIAS;
+    const depth_run_t *run = depth_runs;
+    while (run[1].x <= s->left) {
+        run++;
+    }
 
-        int half_width = sprite_width / 2;
-        if (sprite_screen_x + half_width < 0 || sprite_screen_x - half_width >= SCREEN_WIDTH) {
+    bool drawn = false;
+    int strip = -1;
+    for (; run->x <= s->right; run++) {
+        int a = (run->x > s->left) ? run->x : s->left;
+        if (run->depth >= limit) {
+            if (strip < 0) strip = a;
             continue;
         }
+        int b = (run[1].x <= s->right) ? run[1].x - 1 : s->right;
+        stats.sprite_columns_rejected += b - a + 1;
+        if (strip >= 0) {
+            sprite_strip(s, strip, a - 1);
+            drawn = true;
+            strip = -1;
+        }
+    }
+    if (strip >= 0) {
+        sprite_strip(s, strip, s->right);
+        drawn = true;
+    }
+    return drawn;
+}
 
-        int check_x = sprite_screen_x;
-        if (check_x < 0) check_x = 0;
-        if (check_x >= SCREEN_WIDTH) check_x = SCREEN_WIDTH - 1;
+void raycast_render_enemies(void) {
+    int px = (int)(player_get_view_x() * RAY_ONE);
+    int py = (int)(player_get_view_y() * RAY_ONE);
+    angle_t pangle = (angle_t)(ANGLE_STEPS - player_get_view_angle());
+    trig_t cos_angle = angle_cos(pangle);
+    trig_t sin_angle = angle_sin(pangle);
+
+    const enemy_list_t *enemies = enemy_get_list();
+    int enemy_count = enemy_query_radius(px >> (RAY_SHIFT - FIXED_SHIFT), py >> (RAY_SHIFT - FIXED_SHIFT),
+                                         FIXED_FROM_INT((int)MAX_DEPTH + 1), nearby, MAX_ENEMIES);
+    int player_zone = player_get_zone();
+    int count = 0;
+
+    stats.sprites_drawn = 0;
+    stats.sprite_columns_rejected = 0;
+
+    for (int n = 0; n < enemy_count; n++) {
+        int i = nearby[n];
+        if (!level_zone_sees(player_zone, enemy_get_zone(i))) {
+            continue;
+        }
+
+        int32_t dx = ((int32_t)enemies->view_x[i] << (RAY_SHIFT - FIXED_SHIFT)) - px;
+        int32_t dy = ((int32_t)enemies->view_y[i] << (RAY_SHIFT - FIXED_SHIFT)) - py;
 
-        if (transform_y > depth_buffer[check_x] + 0.1f) {
+        /* Camera space in RAY_SHIFT units; the query radius keeps both products within 32 bits. */
+        int transform_x = (int)((dx * cos_angle - dy * sin_angle) >> TRIG_SHIFT);
+        int transform_y = (int)((dx * sin_angle + dy * cos_angle) >> TRIG_SHIFT);
+
+        if (transform_y <= SPRITE_NEAR_DIST || transform_y >= RAY_MAX_DIST) {
             continue;
         }
 
-        int draw_start_x = sprite_screen_x - sprite_width / 2;
-        int draw_end_x = sprite_screen_x + sprite_width / 2;
-        int draw_start_y = (SCREEN_HEIGHT / 2) - sprite_height / 2;
-        int draw_end_y = (SCREEN_HEIGHT / 2) + sprite_height / 2;
+        /* One divide per sprite; the height comes from the wall projection table. */
+        int sprite_screen_x = (int)((int32_t)(SCREEN_WIDTH / 2) * (transform_y + transform_x) / transform_y);
+        int sprite_height = projection_lookup(transform_y)->line_height;
+        sprite_pick_t pick = sprite_pick(sprite_height);
+        int size = sprite_mip_size(pick.level) * pick.zoom;
 
-        if (draw_start_x < 0) draw_start_x = 0;
-        if (draw_end_x >= SCREEN_WIDTH) draw_end_x = SCREEN_WIDTH - 1;
-        if (draw_start_y < 0) draw_start_y = 0;
-        if (draw_end_y >= SCREEN_HEIGHT) draw_end_y = SCREEN_HEIGHT - 1;
+        int left = sprite_screen_x - size / 2;
+        if (left + size <= 0 || left >= SCREEN_WIDTH) {
+            continue;
+        }
 
-        int width = draw_end_x - draw_start_x + 1;
-        int height = draw_end_y - draw_start_y + 1;
+        sprite_t *s = &sprites[count++];
+        s->depth = transform_y >> (RAY_SHIFT - FIXED_SHIFT);
+        s->enemy = (uint8_t)i;
+        s->type = (enemy_type_t)enemies->type[i];
+        s->pick = pick;
+        s->x = left;
+        s->y = (SCREEN_HEIGHT / 2) - size / 2;
+        s->left = (left < 0) ? 0 : left;
+        s->right = (left + size > SCREEN_WIDTH) ? SCREEN_WIDTH - 1 : left + size - 1;
+    }
 
-        gfx_SetColor(COLOR_ENEMY);
-        gfx_FillRectangle(draw_start_x, draw_start_y, width, height);
+    /* Far to near, so nearer sprites overdraw farther ones; equal depths draw in enemy order. */
+    for (int i = 1; i < count; i++) {
+        sprite_t s = sprites[i];
+        int j = i;
+        while (j > 0 && (sprites[j - 1].depth < s.depth ||
+                         (sprites[j - 1].depth == s.depth && sprites[j - 1].enemy > s.enemy))) {
+            sprites[j] = sprites[j - 1];
+            j--;
+        }
+        sprites[j] = s;
+    }
 
-        gfx_SetColor(255);
-        gfx_Rectangle(draw_start_x, draw_start_y, width, height);
+    for (int i = 0; i < count; i++) {
+        if (sprite_draw(&sprites[i])) {
+            stats.sprites_drawn++;
+        }
     }
 }
 
@@ -329,18 +806,42 @@ void raycast_init(void) {
         palette_data[COLOR_CROSSHAIR] = gfx_RGBTo1555(255, 200, 80);
         palette_data[COLOR_WEAPON_PRIMARY] = gfx_RGBTo1555(140, 100, 70);
         palette_data[COLOR_WEAPON_ACCENT] = gfx_RGBTo1555(170, 170, 170);
+        palette_data[COLOR_WALL_DARKER] = gfx_RGBTo1555(95, 70, 50);
+        palette_data[COLOR_WALL_DARKEST] = gfx_RGBTo1555(60, 45, 30);
+        palette_data[COLOR_WALL_SHADE_DARKER] = gfx_RGBTo1555(55, 80, 105);
+        palette_data[COLOR_WALL_SHADE_DARKEST] = gfx_RGBTo1555(35, 50, 70);
+        palette_data[COLOR_DOOR_DARKER] = gfx_RGBTo1555(75, 55, 20);
+        palette_data[COLOR_DOOR_DARKEST] = gfx_RGBTo1555(45, 30, 10);
+        palette_data[COLOR_EXIT_DARKER] = gfx_RGBTo1555(65, 110, 30);
+        palette_data[COLOR_EXIT_DARKEST] = gfx_RGBTo1555(35, 65, 15);
 
         gfx_SetPalette(palette_data, sizeof(palette_data), 0);
         palette_ready = true;
     }
 
+    projection_init();
+#if RAYCAST_TEXTURED
+    texture_init();
+#endif
+
     float fov_half = FOV / 2.0f;
     float angle_step = FOV / SCREEN_WIDTH;
-    for (int x = 0; x < SCREEN_WIDTH; x++) {
-        float offset = fov_half - angle_step * (float)x;
-        cos_lookup[x] = cosf(offset);
-        sin_lookup[x] = sinf(offset);
-        depth_template[x] = MAX_DEPTH;
+    for (int x = 0; x <= SCREEN_WIDTH; x++) {
+        float offset = (fov_half - angle_step * (float)x) * (ANGLE_STEPS / (2.0f * (float)M_PI));
+        col_angle[x] = (int16_t)((offset < 0.0f) ? offset - 0.5f : offset + 0.5f);
+#if RAYCAST_FLOAT_DDA
+        cos_lookup[x] = angle_cos((angle_t)col_angle[x]) / (float)TRIG_ONE;
+        sin_lookup[x] = angle_sin((angle_t)col_angle[x]) / (float)TRIG_ONE;
+#else
+        col_cos[x] = angle_cos((angle_t)col_angle[x]);
+#endif
     }
+
+    sprite_init();
+
+    depth_runs[0].x = 0;
+    depth_runs[0].depth = DEPTH_FAR;
+    depth_runs[1].x = SCREEN_WIDTH;
+    depth_run_count = 1;
 }
 
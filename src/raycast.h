@@ -8,8 +8,23 @@
 #define RAYCAST_COLOR_WEAPON_PRIMARY 21
 #define RAYCAST_COLOR_WEAPON_ACCENT 22
 
+typedef struct {
+    int rays_cast;
+    int dda_steps;
+    int dda_jumps;
+    int columns_filled;
+    int columns_interpolated;
+    int spans_drawn;
+    int spans_merged;
+    int column_pixels;
+    int sprites_drawn;
+    int sprite_columns_rejected;
+} raycast_stats_t;
+
 void raycast_render(void);
 void raycast_init(void);
 void raycast_render_enemies(void);
+void raycast_set_resolution(int step, int view_height);
+const raycast_stats_t *raycast_get_stats(void);
 
 #endif
@@ -0,0 +1,173 @@
+#include "replay.h"
+
+#if REPLAY_MODE != REPLAY_OFF
+
+#include "input.h"
+#include <fileioc.h>
+#include <string.h>
+
+#define REPLAY_APPVAR "FPSREPL"
+#define REPLAY_MAX_RUNS 4096
+#define RUN_MAX 255
+
+static const uint8_t replay_magic[4] = { 'T', 'F', 'R', '2' };
+
+typedef struct {
+    uint8_t keys;
+    uint8_t length;
+} key_run_t;
+
+static key_run_t runs[REPLAY_MAX_RUNS];
+static int run_count = 0;
+static int run_index = 0;
+static int run_offset = 0;
+static int mode = REPLAY_OFF;
+static uint32_t replay_seed = 0;
+static uint32_t tick_count = 0;
+static bool truncated = false;
+
+static void write_u32(uint8_t handle, uint32_t value) {
+    uint8_t bytes[4] = {
+        (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)
+    };
+    ti_Write(bytes, sizeof(bytes), 1, handle);
+}
+
+static bool read_u32(uint8_t handle, uint32_t *value) {
+    uint8_t bytes[4];
+    if (ti_Read(bytes, sizeof(bytes), 1, handle) != 1) {
+        return false;
+    }
+    *value = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+             ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    return true;
+}
+
+void replay_record_start(uint32_t seed) {
+    mode = REPLAY_RECORD;
+    replay_seed = seed;
+    run_count = 0;
+    tick_count = 0;
+    truncated = false;
+}
+
+/*
+ * Layout: magic, seed, tick count, run count, a truncated flag byte, then
+ * (keys, length) pairs; integers little-endian.
+ */
+bool replay_play_start(uint32_t *seed) {
+    uint8_t handle = ti_Open(REPLAY_APPVAR, "r");
+    if (!handle) {
+        return false;
+    }
+
+    uint8_t magic[4];
+    uint32_t ticks, count;
+    uint8_t flag;
+    bool ok = ti_Read(magic, sizeof(magic), 1, handle) == 1 &&
+              memcmp(magic, replay_magic, sizeof(magic)) == 0 &&
+              read_u32(handle, &replay_seed) &&
+              read_u32(handle, &ticks) &&
+              read_u32(handle, &count) &&
+              count <= REPLAY_MAX_RUNS &&
+              ti_Read(&flag, 1, 1, handle) == 1 &&
+              (count == 0 || ti_Read(runs, sizeof(key_run_t), count, handle) == count);
+    ti_Close(handle);
+
+    if (!ok) {
+        mode = REPLAY_OFF;
+        return false;
+    }
+
+    mode = REPLAY_PLAY;
+    run_count = (int)count;
+    run_index = 0;
+    run_offset = 0;
+    tick_count = 0;
+    truncated = flag != 0;
+    *seed = replay_seed;
+    return true;
+}
+
+void replay_stop(void) {
+    if (mode == REPLAY_RECORD) {
+        uint8_t handle = ti_Open(REPLAY_APPVAR, "w");
+        if (handle) {
+            ti_Write(replay_magic, sizeof(replay_magic), 1, handle);
+            write_u32(handle, replay_seed);
+            write_u32(handle, tick_count);
+            write_u32(handle, (uint32_t)run_count);
+            uint8_t flag = truncated;
+            ti_Write(&flag, 1, 1, handle);
+            if (run_count > 0) {
+                ti_Write(runs, sizeof(key_run_t), (size_t)run_count, handle);
+            }
+            ti_Close(handle);
+        }
+    }
+    mode = REPLAY_OFF;
+}
+
+/* A full buffer ends the recording: later ticks are dropped and the replay is flagged as cut short. */
+static void record_tick(uint8_t keys) {
+    if (truncated) {
+        return;
+    }
+    if (run_count > 0) {
+        key_run_t *last = &runs[run_count - 1];
+        if (last->keys == keys && last->length < RUN_MAX) {
+            last->length++;
+            tick_count++;
+            return;
+        }
+    }
+    if (run_count == REPLAY_MAX_RUNS) {
+        truncated = true;
+        return;
+    }
+    runs[run_count].keys = keys;
+    runs[run_count].length = 1;
+    run_count++;
+    tick_count++;
+}
+
+/* Once the stream runs out the game is told to quit; a live quit key always aborts playback. */
+static uint8_t play_tick(uint8_t keys) {
+    uint8_t quit = (uint8_t)(1 << INPUT_QUIT);
+
+    if (run_index >= run_count) {
+        return quit;
+    }
+
+    uint8_t recorded = runs[run_index].keys;
+    if (++run_offset >= runs[run_index].length) {
+        run_index++;
+        run_offset = 0;
+    }
+    tick_count++;
+    return recorded | (keys & quit);
+}
+
+/* Called once per simulation tick with the live key state; returns the state the tick should use. */
+uint8_t replay_filter(uint8_t keys) {
+    if (mode == REPLAY_RECORD) {
+        record_tick(keys);
+    } else if (mode == REPLAY_PLAY) {
+        return play_tick(keys);
+    }
+    return keys;
+}
+
+int replay_get_mode(void) {
+    return mode;
+}
+
+uint32_t replay_get_ticks(void) {
+    return tick_count;
+}
+
+bool replay_is_truncated(void) {
+    return truncated;
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define REPLAY_OFF 0
+#define REPLAY_RECORD 1
+#define REPLAY_PLAY 2
+
+#ifndef REPLAY_MODE
+#define REPLAY_MODE REPLAY_OFF
+#endif
+
+#if REPLAY_MODE != REPLAY_OFF
+void replay_record_start(uint32_t seed);
+bool replay_play_start(uint32_t *seed);
+void replay_stop(void);
+uint8_t replay_filter(uint8_t keys);
+int replay_get_mode(void);
+uint32_t replay_get_ticks(void);
+bool replay_is_truncated(void);
+#else
+static inline void replay_record_start(uint32_t seed) { (void)seed; }
+static inline bool replay_play_start(uint32_t *seed) { (void)seed; return false; }
+static inline void replay_stop(void) {}
+static inline uint8_t replay_filter(uint8_t keys) { return keys; }
+static inline int replay_get_mode(void) { return REPLAY_OFF; }
+static inline uint32_t replay_get_ticks(void) { return 0; }
+static inline bool replay_is_truncated(void) { return false; }
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+#include "scaler.h"
+#include "clock.h"
+
+#define TARGET_FPS 15
+#define TARGET_TICKS (CLOCK_HZ / TARGET_FPS)
+#define SLOW_TICKS (TARGET_TICKS + TARGET_TICKS / 8)
+#define FAST_TICKS (TARGET_TICKS - TARGET_TICKS / 4)
+
+#define SLOW_FRAMES 4
+#define FAST_FRAMES 24
+#define SETTLE_FRAMES 8
+#define AVERAGE_SHIFT 2
+#define START_LEVEL 3
+
+typedef struct {
+    uint8_t ray_step;
+    uint8_t view_height;
+} scaler_level_t;
+
+static const scaler_level_t levels[] = {
+    { 2, 240 },
+    { 3, 240 },
+    { 4, 240 },
+    { 5, 240 },
+    { 8, 240 },
+    { 8, 200 },
+    { 10, 160 }
+};
+
+#define LEVEL_COUNT ((int)(sizeof(levels) / sizeof(levels[0])))
+
+static int level = START_LEVEL;
+static uint32_t average_ticks = TARGET_TICKS;
+static int slow_count = 0;
+static int fast_count = 0;
+static int settle_count = 0;
+
+void scaler_init(void) {
+    level = START_LEVEL;
+    average_ticks = TARGET_TICKS;
+    slow_count = 0;
+    fast_count = 0;
+    settle_count = SETTLE_FRAMES;
+}
+
+void scaler_frame(uint32_t frame_ticks) {
+    average_ticks += (frame_ticks >> AVERAGE_SHIFT) - (average_ticks >> AVERAGE_SHIFT);
+
+    if (settle_count > 0) {
+        settle_count--;
+        return;
+    }
+
+    slow_count = (average_ticks > SLOW_TICKS) ? slow_count + 1 : 0;
+    fast_count = (average_ticks < FAST_TICKS) ? fast_count + 1 : 0;
+
+    int next = level;
+    if (slow_count >= SLOW_FRAMES && level < LEVEL_COUNT - 1) {
+        next = level + 1;
+    } else if (fast_count >= FAST_FRAMES && level > 0) {
+        next = level - 1;
+    }
+
+    if (next != level) {
+        level = next;
+        slow_count = 0;
+        fast_count = 0;
+        settle_count = SETTLE_FRAMES;
+    }
+}
+
+int scaler_get_level(void) {
+    return level;
+}
+
+int scaler_get_level_count(void) {
+    return LEVEL_COUNT;
+}
+
+uint32_t scaler_get_frame_ticks(void) {
+    return average_ticks;
+}
+
+int scaler_get_ray_step(void) {
+    return levels[level].ray_step;
+}
+
+int scaler_get_view_height(void) {
+    return levels[level].view_height;
+}
@@ -0,0 +1,14 @@
+#ifndef SCALER_H
+#define SCALER_H
+
+#include <stdint.h>
+
+void scaler_init(void);
+void scaler_frame(uint32_t frame_ticks);
+int scaler_get_level(void);
+int scaler_get_level_count(void);
+uint32_t scaler_get_frame_ticks(void);
+int scaler_get_ray_step(void);
+int scaler_get_view_height(void);
+
+#endif
@@ -0,0 +1,189 @@
+#include "sprite.h"
+#include "blit.h"
+#include <graphx.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/*
+ * Art is 32x32, row-major and run-length coded: each byte is (run - 1) << 3
+ * | code, where code 0 is transparent and codes 1-7 index the type's colours.
+ */
+static const uint8_t imp_art[] = {
+    0x40, 0x01, 0x07, 0x01, 0x38, 0x01, 0x07, 0x01, 0x90, 0x01, 0x07, 0x01,
+    0x28, 0x01, 0x07, 0x01, 0x98, 0x01, 0x0f, 0x29, 0x0f, 0x01, 0x98, 0x01,
+    0x17, 0x1b, 0x17, 0x01, 0xa0, 0x01, 0x07, 0x2b, 0x07, 0x01, 0xa8, 0x01,
+    0x3b, 0x01, 0xa0, 0x01, 0x43, 0x02, 0x01, 0x98, 0x01, 0x0b, 0x0d, 0x13,
+    0x0d, 0x02, 0x01, 0x98, 0x01, 0x0b, 0x0d, 0x13, 0x0d, 0x02, 0x01, 0x98,
+    0x01, 0x43, 0x02, 0x01, 0xa0, 0x01, 0x3b, 0x01, 0xa8, 0x01, 0x0b, 0x26,
+    0x03, 0x01, 0xa0, 0x01, 0x43, 0x02, 0x01, 0x90, 0x01, 0x23, 0x0c, 0x13,
+    0x0a, 0x01, 0x78, 0x09, 0x13, 0x52, 0x09, 0x60, 0x01, 0x03, 0x01, 0x1b,
+    0x2c, 0x03, 0x12, 0x01, 0x02, 0x01, 0x58, 0x01, 0x03, 0x01, 0x1b, 0x2c,
+    0x03, 0x12, 0x01, 0x02, 0x01, 0x50, 0x01, 0x2b, 0x6a, 0x01, 0x48, 0x01,
+    0x33, 0x2c, 0x03, 0x2a, 0x01, 0x40, 0x01, 0x43, 0x1c, 0x0b, 0x32, 0x01,
+    0x38, 0x01, 0x13, 0x09, 0x0b, 0x4a, 0x09, 0x12, 0x01, 0x30, 0x01, 0x13,
+    0x01, 0x08, 0x01, 0x43, 0x02, 0x01, 0x08, 0x01, 0x12, 0x01, 0x28, 0x01,
+    0x03, 0x09, 0x10, 0x01, 0x02, 0x3b, 0x02, 0x01, 0x10, 0x09, 0x02, 0x01,
+    0x20, 0x01, 0x03, 0x01, 0x20, 0x01, 0x0a, 0x2b, 0x0a, 0x01, 0x20, 0x01,
+    0x02, 0x09, 0x08, 0x01, 0x16, 0x01, 0x18, 0x01, 0x1a, 0x09, 0x1a, 0x01,
+    0x20, 0x01, 0x16, 0x01, 0x00, 0x01, 0x16, 0x01, 0x18, 0x01, 0x1a, 0x09,
+    0x1a, 0x01, 0x20, 0x01, 0x16, 0x01, 0x00, 0x01, 0x16, 0x01, 0x18, 0x01,
+    0x1a, 0x09, 0x1a, 0x01, 0x20, 0x01, 0x16, 0x01, 0x08, 0x11, 0x20, 0x01,
+    0x1a, 0x09, 0x1a, 0x01, 0x28, 0x11, 0x50, 0x01, 0x1a, 0x09, 0x1a, 0x01,
+    0x98, 0x01, 0x1a, 0x09, 0x1a, 0x01, 0x98, 0x01, 0x1a, 0x09, 0x1a, 0x01,
+    0x98, 0x01, 0x1a, 0x09, 0x1a, 0x01, 0x48
+};
+
+static const uint8_t demon_art[] = {
+    0xf8, 0x18, 0x01, 0xa0, 0x01, 0x38, 0x01, 0x06, 0x01, 0x90, 0x01, 0x06,
+    0x01, 0x38, 0x01, 0x06, 0x09, 0x70, 0x09, 0x06, 0x01, 0x48, 0x01, 0x0e,
+    0x01, 0x60, 0x01, 0x0e, 0x01, 0x50, 0x01, 0x16, 0x01, 0x08, 0x39, 0x00,
+    0x01, 0x16, 0x01, 0x58, 0x01, 0x16, 0x09, 0x3b, 0x01, 0x16, 0x01, 0x68,
+    0x01, 0x06, 0x01, 0x4b, 0x0a, 0x06, 0x01, 0x70, 0x09, 0x53, 0x12, 0x09,
+    0x60, 0x01, 0x13, 0x15, 0x2b, 0x15, 0x12, 0x01, 0x58, 0x01, 0x13, 0x15,
+    0x2b, 0x15, 0x12, 0x01, 0x58, 0x01, 0x63, 0x22, 0x01, 0x50, 0x01, 0x6b,
+    0x2a, 0x01, 0x40, 0x01, 0x73, 0x32, 0x01, 0x30, 0x01, 0x7b, 0x3a, 0x01,
+    0x28, 0x01, 0x7b, 0x3a, 0x01, 0x20, 0x01, 0x2b, 0x04, 0x4b, 0x0a, 0x04,
+    0x2a, 0x01, 0x18, 0x01, 0x23, 0x0c, 0x06, 0x07, 0x06, 0x07, 0x06, 0x07,
+    0x06, 0x07, 0x06, 0x07, 0x06, 0x07, 0x0c, 0x22, 0x01, 0x18, 0x01, 0x23,
+    0x0c, 0x06, 0x07, 0x06, 0x07, 0x06, 0x07, 0x06, 0x07, 0x06, 0x07, 0x06,
+    0x07, 0x0c, 0x22, 0x01, 0x18, 0x01, 0x23, 0x0c, 0x5f, 0x0c, 0x22, 0x01,
+    0x18, 0x01, 0x23, 0x0c, 0x5f, 0x0c, 0x22, 0x01, 0x18, 0x01, 0x2b, 0x04,
+    0x07, 0x06, 0x07, 0x06, 0x07, 0x06, 0x07, 0x06, 0x07, 0x06, 0x07, 0x06,
+    0x04, 0x2a, 0x01, 0x20, 0x01, 0x2b, 0x07, 0x06, 0x07, 0x06, 0x07, 0x06,
+    0x07, 0x06, 0x07, 0x06, 0x07, 0x06, 0x2a, 0x01, 0x28, 0x01, 0x33, 0x4c,
+    0x32, 0x01, 0x30, 0x01, 0x3b, 0x2c, 0x03, 0x32, 0x01, 0x40, 0x01, 0x6b,
+    0x2a, 0x01, 0x50, 0x01, 0x63, 0x22, 0x01, 0x58, 0x01, 0x0a, 0x53, 0x22,
+    0x01, 0x58, 0x01, 0x22, 0x3b, 0x22, 0x01, 0x58, 0x01, 0x22, 0x39, 0x22,
+    0x01, 0x58, 0x01, 0x22, 0x01, 0x28, 0x01, 0x22, 0x01, 0x58, 0x01, 0x22,
+    0x01, 0x28, 0x01, 0x22, 0x01, 0x28
+};
+
+static const uint8_t baron_art[] = {
+    0x30, 0x01, 0x06, 0x11, 0x08, 0x19, 0x08, 0x11, 0x06, 0x01, 0x70, 0x01,
+    0x16, 0x09, 0x1b, 0x09, 0x16, 0x01, 0x80, 0x01, 0x16, 0x2b, 0x16, 0x01,
+    0x90, 0x01, 0x06, 0x3b, 0x06, 0x01, 0xa0, 0x01, 0x0b, 0x05, 0x13, 0x05,
+    0x03, 0x01, 0xa8, 0x01, 0x0b, 0x05, 0x13, 0x05, 0x03, 0x01, 0xa8, 0x01,
+    0x3b, 0x01, 0xa0, 0x01, 0x43, 0x02, 0x01, 0x70, 0x21, 0x4b, 0x0a, 0x21,
+    0x40, 0x01, 0x43, 0x1c, 0x0b, 0x32, 0x01, 0x38, 0x01, 0x3b, 0x2c, 0x03,
+    0x32, 0x01, 0x38, 0x01, 0x3b, 0x2c, 0x03, 0x32, 0x01, 0x38, 0x01, 0x33,
+    0x3c, 0x32, 0x01, 0x38, 0x01, 0x33, 0x3c, 0x32, 0x01, 0x38, 0x01, 0x33,
+    0x3c, 0x32, 0x01, 0x38, 0x01, 0x33, 0x3c, 0x32, 0x01, 0x38, 0x01, 0x3b,
+    0x2c, 0x03, 0x32, 0x01, 0x38, 0x01, 0x3b, 0x2c, 0x03, 0x32, 0x01, 0x38,
+    0x01, 0x43, 0x1c, 0x0b, 0x32, 0x01, 0x38, 0x01, 0x1b, 0x01, 0x4b, 0x0a,
+    0x01, 0x1a, 0x01, 0x38, 0x01, 0x1b, 0x09, 0x43, 0x02, 0x09, 0x1a, 0x01,
+    0x38, 0x01, 0x1b, 0x09, 0x0a, 0x2b, 0x0a, 0x09, 0x1a, 0x01, 0x30, 0x01,
+    0x26, 0x09, 0x1a, 0x09, 0x1a, 0x09, 0x26, 0x01, 0x28, 0x01, 0x26, 0x09,
+    0x1a, 0x09, 0x1a, 0x09, 0x26, 0x01, 0x28, 0x01, 0x26, 0x09, 0x1a, 0x09,
+    0x1a, 0x09, 0x26, 0x01, 0x30, 0x21, 0x00, 0x01, 0x1a, 0x09, 0x1a, 0x01,
+    0x00, 0x21, 0x68, 0x01, 0x1a, 0x09, 0x1a, 0x01, 0x98, 0x01, 0x1a, 0x09,
+    0x1a, 0x01, 0x90, 0x01, 0x27, 0x09, 0x27, 0x01, 0x88, 0x01, 0x27, 0x09,
+    0x27, 0x01, 0x88, 0x01, 0x27, 0x09, 0x27, 0x01, 0x88, 0x01, 0x27, 0x09,
+    0x27, 0x01, 0x40
+};
+static const uint8_t *const sprite_art[ENEMY_TYPE_COUNT] = { imp_art, demon_art, baron_art };
+
+static const uint16_t sprite_palette[ENEMY_TYPE_COUNT * SPRITE_PALETTE_COLORS] = {
+    gfx_RGBTo1555(40, 20, 10), gfx_RGBTo1555(110, 55, 25), gfx_RGBTo1555(160, 90, 45), gfx_RGBTo1555(210, 150, 90),
+    gfx_RGBTo1555(255, 170, 0), gfx_RGBTo1555(240, 230, 200), gfx_RGBTo1555(90, 70, 60),
+    gfx_RGBTo1555(40, 10, 20), gfx_RGBTo1555(150, 50, 80), gfx_RGBTo1555(210, 100, 130), gfx_RGBTo1555(240, 160, 180),
+    gfx_RGBTo1555(255, 240, 80), gfx_RGBTo1555(250, 250, 240), gfx_RGBTo1555(90, 10, 20),
+    gfx_RGBTo1555(20, 30, 10), gfx_RGBTo1555(60, 110, 40), gfx_RGBTo1555(110, 160, 70), gfx_RGBTo1555(220, 170, 150),
+    gfx_RGBTo1555(230, 40, 40), gfx_RGBTo1555(240, 230, 200), gfx_RGBTo1555(60, 40, 30)
+};
+
+static const uint8_t mip_sizes[SPRITE_MIP_COUNT] = { 32, 24, 16, 12, 8 };
+static const uint16_t mip_offsets[SPRITE_MIP_COUNT] = { 0, 1024, 1600, 1856, 2000 };
+
+/* Column-major mips, texel 0 transparent, rebuilt from the art at every level start. */
+static uint8_t mip_cache[ENEMY_TYPE_COUNT][SPRITE_CACHE_SIZE];
+static bool tables_ready = false;
+
+sprite_pick_t sprite_pick_table[SPRITE_PICK_MAX + 1];
+
+static void unpack_art(const uint8_t *rle, uint8_t base, uint8_t *dst) {
+    int x = 0;
+    int y = 0;
+    while (y < SPRITE_SIZE) {
+        uint8_t code = *rle & 7;
+        uint8_t color = code ? (uint8_t)(base + code - 1) : 0;
+        for (int run = (*rle++ >> 3) + 1; run > 0; run--) {
+            dst[x * SPRITE_SIZE + y] = color;
+            if (++x == SPRITE_SIZE) {
+                x = 0;
+                y++;
+            }
+        }
+    }
+}
+
+static void build_mip(uint8_t *dst, const uint8_t *src, int size) {
+    int step = (SPRITE_SIZE << 8) / size;
+    for (int col = 0; col < size; col++) {
+        const uint8_t *column = src + ((col * step + step / 2) >> 8) * SPRITE_SIZE;
+        for (int row = 0; row < size; row++) {
+            *dst++ = column[(row * step + step / 2) >> 8];
+        }
+    }
+}
+
+static void build_pick_table(void) {
+    for (int height = 1; height <= SPRITE_PICK_MAX; height++) {
+        int best_err = SPRITE_PICK_MAX;
+        for (int level = 0; level < SPRITE_MIP_COUNT; level++) {
+            int size = mip_sizes[level];
+            int zoom = (height + size / 2) / size;
+            if (zoom < 1) zoom = 1;
+            int err = abs(zoom * size - height);
+            if (err < best_err) {
+                best_err = err;
+                sprite_pick_table[height].level = (uint8_t)level;
+                sprite_pick_table[height].zoom = (uint8_t)zoom;
+            }
+        }
+    }
+    sprite_pick_table[0] = sprite_pick_table[1];
+}
+
+void sprite_init(void) {
+    if (!tables_ready) {
+        gfx_SetPalette(sprite_palette, sizeof(sprite_palette), SPRITE_PALETTE_BASE);
+        build_pick_table();
+        tables_ready = true;
+    }
+
+    for (int type = 0; type < ENEMY_TYPE_COUNT; type++) {
+        uint8_t *cache = mip_cache[type];
+        unpack_art(sprite_art[type], (uint8_t)(SPRITE_PALETTE_BASE + type * SPRITE_PALETTE_COLORS), cache);
+        for (int level = 1; level < SPRITE_MIP_COUNT; level++) {
+            build_mip(cache + mip_offsets[level], cache, mip_sizes[level]);
+        }
+    }
+}
+
+int sprite_mip_size(int level) {
+    return mip_sizes[level];
+}
+
+size_t sprite_mip_bytes(int level) {
+    return (size_t)mip_sizes[level] * mip_sizes[level] * ENEMY_TYPE_COUNT;
+}
+
+const uint8_t *sprite_mip(enemy_type_t type, int level) {
+    return mip_cache[type] + mip_offsets[level];
+}
+
+/* Draws screen columns first..last of a sprite whose unclipped top-left corner is (x, y). */
+void sprite_blit(enemy_type_t type, sprite_pick_t pick, int x, int y, int first, int last) {
+    int size = mip_sizes[pick.level];
+    int offset = first - x;
+    const uint8_t *column = sprite_mip(type, pick.level) + (offset / pick.zoom) * size;
+    int repeat = pick.zoom - offset % pick.zoom;
+
+    while (first <= last) {
+        int width = (repeat < last - first + 1) ? repeat : last - first + 1;
+        blit_sprite_column(first, width, y, column, size, pick.zoom);
+        first += width;
+        column += size;
+        repeat = pick.zoom;
+    }
+}
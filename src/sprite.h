@@ -0,0 +1,37 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "enemy.h"
+
+#define SPRITE_SIZE 32
+#define SPRITE_MIP_COUNT 5
+#define SPRITE_CACHE_SIZE (32 * 32 + 24 * 24 + 16 * 16 + 12 * 12 + 8 * 8)
+#define SPRITE_PICK_MAX 255
+#define SPRITE_PALETTE_BASE 32
+#define SPRITE_PALETTE_COLORS 7
+
+typedef struct {
+    uint8_t level;
+    uint8_t zoom;
+} sprite_pick_t;
+
+extern sprite_pick_t sprite_pick_table[SPRITE_PICK_MAX + 1];
+
+void sprite_init(void);
+int sprite_mip_size(int level);
+size_t sprite_mip_bytes(int level);
+const uint8_t *sprite_mip(enemy_type_t type, int level);
+void sprite_blit(enemy_type_t type, sprite_pick_t pick, int x, int y, int first, int last);
+
+/* Mip level and integer zoom whose drawn size is nearest a projected height. */
+static inline sprite_pick_t sprite_pick(int height) {
+    if (height <= SPRITE_PICK_MAX) {
+        return sprite_pick_table[height < 1 ? 1 : height];
+    }
+    sprite_pick_t pick = { 0, (uint8_t)((height + SPRITE_SIZE / 2) / SPRITE_SIZE) };
+    return pick;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "texture.h"
+#include <stdbool.h>
+
+#define BRICK_HEIGHT 8
+#define BRICK_WIDTH 16
+#define PLANK_WIDTH 8
+
+uint8_t texture_data[LEVEL_CELL_EXIT][TEX_SIZE * TEX_SIZE];
+uint16_t texture_step_table[PROJ_HEIGHT_MAX + 1];
+
+static bool textures_ready = false;
+
+static uint8_t brick_tone(int x, int y) {
+    int row = y / BRICK_HEIGHT;
+    int bx = (x + ((row & 1) ? BRICK_WIDTH / 2 : 0)) % BRICK_WIDTH;
+    int by = y % BRICK_HEIGHT;
+    if (by == BRICK_HEIGHT - 1 || bx == BRICK_WIDTH - 1) return 2;
+    if (by == BRICK_HEIGHT - 2 || bx == BRICK_WIDTH - 2) return 1;
+    return ((x * 7 + y * 13) % 11 == 0) ? 1 : 0;
+}
+
+static uint8_t door_tone(int x, int y) {
+    if (x == 0 || x == TEX_SIZE - 1 || y == 0) return 2;
+    if (y == 6 || y == 7 || y == 24 || y == 25) {
+        return (x == 3 || x == TEX_SIZE - 4) ? 2 : 1;
+    }
+    if (x % PLANK_WIDTH == 0) return 2;
+    return ((y + x * 5) % 9 == 0) ? 1 : 0;
+}
+
+static uint8_t exit_tone(int x, int y) {
+    if (x < 2 || x >= TEX_SIZE - 2 || y < 2 || y >= TEX_SIZE - 2) return 2;
+    int cx = x - TEX_SIZE / 2;
+    int cy = y - TEX_SIZE / 2;
+    if (cx < 0) cx = -cx;
+    if (cy >= -10 && cy < 0 && cx <= cy + 10) return 0;
+    if (cy >= 0 && cy <= 9 && cx <= 2) return 0;
+    return 1;
+}
+
+void texture_init(void) {
+    if (textures_ready) {
+        return;
+    }
+
+    for (int x = 0; x < TEX_SIZE; x++) {
+        uint8_t *wall = &texture_data[LEVEL_CELL_WALL - 1][x << TEX_SHIFT];
+        uint8_t *door = &texture_data[LEVEL_CELL_DOOR - 1][x << TEX_SHIFT];
+        uint8_t *exit = &texture_data[LEVEL_CELL_EXIT - 1][x << TEX_SHIFT];
+        for (int y = 0; y < TEX_SIZE; y++) {
+            wall[y] = brick_tone(x, y);
+            door[y] = door_tone(x, y);
+            exit[y] = exit_tone(x, y);
+        }
+    }
+
+    texture_step_table[0] = TEX_SIZE << TEX_STEP_SHIFT;
+    for (int h = 1; h <= PROJ_HEIGHT_MAX; h++) {
+        texture_step_table[h] = (uint16_t)((TEX_SIZE << TEX_STEP_SHIFT) / h);
+    }
+    textures_ready = true;
+}
@@ -0,0 +1,28 @@
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <stdint.h>
+#include "level.h"
+#include "projection.h"
+
+#define TEX_SHIFT 5
+#define TEX_SIZE (1 << TEX_SHIFT)
+#define TEX_STEP_SHIFT 10
+#define TEX_TONES 3
+
+extern uint8_t texture_data[LEVEL_CELL_EXIT][TEX_SIZE * TEX_SIZE];
+extern uint16_t texture_step_table[PROJ_HEIGHT_MAX + 1];
+
+void texture_init(void);
+
+/* Column u of the texture for a non-empty cell; texels are tones 0 (lit) to TEX_TONES - 1 (darkest). */
+static inline const uint8_t *texture_column(uint8_t cell, int u) {
+    return &texture_data[cell - 1][u << TEX_SHIFT];
+}
+
+/* Texel step per screen row for a wall slice line_height rows tall, in TEX_STEP_SHIFT units. */
+static inline int texture_step(int line_height) {
+    return texture_step_table[line_height];
+}
+
+#endif
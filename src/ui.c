@@ -1,7 +1,7 @@
 #include "ui.h"
 #include "player.h"
 #include "raycast.h"
-#include <graphx.h>
+#include "blit.h"
 
 #define BAR_WIDTH 100
 #define BAR_HEIGHT 8
@@ -30,50 +30,41 @@ void ui_render(void) {
     int max_hp = 100;
     int max_ammo = 50;
 
-    gfx_SetColor(255);
-    gfx_Rectangle(BAR_X, HP_BAR_Y, BAR_WIDTH, BAR_HEIGHT);
+    blit_rect(BAR_X, HP_BAR_Y, BAR_WIDTH, BAR_HEIGHT, 255);
     int hp_width = (hp * (BAR_WIDTH - 2)) / max_hp;
     if (hp_width > 0) {
-        gfx_SetColor(RAYCAST_COLOR_HP_FILL);
-        gfx_FillRectangle(BAR_X + 1, HP_BAR_Y + 1, hp_width, BAR_HEIGHT - 2);
+        blit_fill_rect(BAR_X + 1, HP_BAR_Y + 1, hp_width, BAR_HEIGHT - 2, RAYCAST_COLOR_HP_FILL);
     }
 
-    gfx_SetColor(255);
-    gfx_Rectangle(BAR_X, AMMO_BAR_Y, BAR_WIDTH, BAR_HEIGHT);
+    blit_rect(BAR_X, AMMO_BAR_Y, BAR_WIDTH, BAR_HEIGHT, 255);
     int ammo_width = (ammo * (BAR_WIDTH - 2)) / max_ammo;
     if (ammo_width > 0) {
-        gfx_SetColor(RAYCAST_COLOR_AMMO_FILL);
-        gfx_FillRectangle(BAR_X + 1, AMMO_BAR_Y + 1, ammo_width, BAR_HEIGHT - 2);
+        blit_fill_rect(BAR_X + 1, AMMO_BAR_Y + 1, ammo_width, BAR_HEIGHT - 2, RAYCAST_COLOR_AMMO_FILL);
     }
 
-    gfx_SetColor(RAYCAST_COLOR_WEAPON_PRIMARY);
-    gfx_FillRectangle(WEAPON_X + 15, WEAPON_Y + 20, 10, 30);
-    gfx_FillRectangle(WEAPON_X + 18, WEAPON_Y + 45, 4, 12);
-    gfx_SetColor(RAYCAST_COLOR_WEAPON_ACCENT);
-    gfx_FillRectangle(WEAPON_X + 17, WEAPON_Y + 10, 6, 15);
+    blit_fill_rect(WEAPON_X + 15, WEAPON_Y + 20, 10, 30, RAYCAST_COLOR_WEAPON_PRIMARY);
+    blit_fill_rect(WEAPON_X + 18, WEAPON_Y + 45, 4, 12, RAYCAST_COLOR_WEAPON_PRIMARY);
+    blit_fill_rect(WEAPON_X + 17, WEAPON_Y + 10, 6, 15, RAYCAST_COLOR_WEAPON_ACCENT);
 
-    gfx_SetColor(255);
-    gfx_Rectangle(WEAPON_X + 15, WEAPON_Y + 20, 10, 30);
-    gfx_Rectangle(WEAPON_X + 17, WEAPON_Y + 10, 6, 15);
-    gfx_Rectangle(WEAPON_X + 18, WEAPON_Y + 45, 4, 12);
-    gfx_Line(WEAPON_X + 17, WEAPON_Y + 25, WEAPON_X + 17, WEAPON_Y + 20);
-    gfx_Line(WEAPON_X + 23, WEAPON_Y + 25, WEAPON_X + 23, WEAPON_Y + 20);
+    blit_rect(WEAPON_X + 15, WEAPON_Y + 20, 10, 30, 255);
+    blit_rect(WEAPON_X + 17, WEAPON_Y + 10, 6, 15, 255);
+    blit_rect(WEAPON_X + 18, WEAPON_Y + 45, 4, 12, 255);
+    blit_vline(WEAPON_X + 17, WEAPON_Y + 20, 6, 255);
+    blit_vline(WEAPON_X + 23, WEAPON_Y + 20, 6, 255);
 
     if (muzzle_flash || player_is_shooting()) {
-        gfx_SetColor(255);
-        gfx_Rectangle(WEAPON_X + 16, WEAPON_Y + 5, 8, 8);
-        gfx_Line(WEAPON_X + 16, WEAPON_Y + 9, WEAPON_X + 24, WEAPON_Y + 9);
-        gfx_Line(WEAPON_X + 20, WEAPON_Y + 5, WEAPON_X + 20, WEAPON_Y + 13);
+        blit_rect(WEAPON_X + 16, WEAPON_Y + 5, 8, 8, 255);
+        blit_hline(WEAPON_X + 16, WEAPON_Y + 9, 9, 255);
+        blit_vline(WEAPON_X + 20, WEAPON_Y + 5, 9, 255);
     }
 }
 
 void ui_render_crosshair(void) {
-    gfx_SetColor(RAYCAST_COLOR_CROSSHAIR);
-    gfx_Line(CROSSHAIR_X - CROSSHAIR_SIZE, CROSSHAIR_Y,
-             CROSSHAIR_X + CROSSHAIR_SIZE, CROSSHAIR_Y);
-    gfx_Line(CROSSHAIR_X, CROSSHAIR_Y - CROSSHAIR_SIZE,
-             CROSSHAIR_X, CROSSHAIR_Y + CROSSHAIR_SIZE);
-    gfx_SetPixel(CROSSHAIR_X, CROSSHAIR_Y);
+    blit_hline(CROSSHAIR_X - CROSSHAIR_SIZE, CROSSHAIR_Y,
+               CROSSHAIR_SIZE * 2 + 1, RAYCAST_COLOR_CROSSHAIR);
+    blit_vline(CROSSHAIR_X, CROSSHAIR_Y - CROSSHAIR_SIZE,
+               CROSSHAIR_SIZE * 2 + 1, RAYCAST_COLOR_CROSSHAIR);
+    blit_pixel(CROSSHAIR_X, CROSSHAIR_Y, RAYCAST_COLOR_CROSSHAIR);
 }
 
 void ui_set_muzzle_flash(bool active) {